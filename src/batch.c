@@ -0,0 +1,155 @@
+/**
+ * @file batch.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Color many tiny graphs without the supervisor and print the removed edges of each.
+ *
+ * @details Read one graph per line from a file or stdin, with the edges written as on the generator command line.
+ * The graphs may have at most TINY_NODES nodes. They are read in batches of BATCH_LEN and searched LANES at a time
+ * by the vectorized batch search, and for every graph a line in the format of the supervisor is printed in input
+ * order. No shared memory is involved, so thousands of graphs don't pay the start-up and synchronization cost of a
+ * supervisor and generator each.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <limits.h>
+#include "common.h"
+#include "tiny.h"
+
+#define BATCH_LEN   1024    /**< The number of graphs read before they are searched. */
+
+// Prototypes
+/**
+ * @brief Write helpful usage information about the program to stderr.
+ * 
+ * @details Global variables: myprog.
+ */
+static void usage(void);
+
+/**
+ * @brief Parse a line of edges into a tiny graph.
+ * 
+ * @param line  The line, which is modified.
+ * @param g     The graph which should be filled.
+ * @return Returns 0 on success and -1 if an edge is malformed or has a node number of TINY_NODES or more.
+ */
+static int parseLine(char *line, tiny_t *g);
+
+/**
+ * @brief Print the result of a tiny graph in the format of the supervisor.
+ * 
+ * @param g The searched graph.
+ */
+static void printResult(const tiny_t *g);
+
+/**
+ * @brief Main function.
+ * 
+ * @details Handle command line arguments and execute the program. Global variables: myprog.
+ * 
+ * @param argc  The argument count.
+ * @param argv  The list of arguments.
+ * @return Returns EXIT_SUCCESS on successful exit otherwise returns EXIT_FAILURE.
+ */
+int main(int argc, char **argv) {
+    myprog = argv[0];
+    if (argc > 2)
+        usage();
+    FILE *in = stdin;
+    if (argc == 2 && (in = fopen(argv[1], "r")) == NULL)
+        error_exit("Failed to open graph file");
+    srandom(getpid());
+
+    tiny_t *graphs = malloc(BATCH_LEN * sizeof(tiny_t));
+    if (graphs == NULL)
+        error_exit("Failed to allocate graphs");
+    char *line = NULL;
+    size_t cap = 0;
+    long lineNum = 0;
+    int n = 0, end = 0;
+    while (!end) {
+        end = getline(&line, &cap, in) < 0;
+        if (!end) {
+            lineNum++;
+            if (parseLine(line, &graphs[n++]) < 0) {
+                char errstr[64];
+                snprintf(errstr, sizeof(errstr), "Failed to parse graph at line %ld", lineNum);
+                error_exit(errstr);
+            }
+        }
+        if (n == BATCH_LEN || (end && n > 0)) {
+            solveTinyGraphs(graphs, n);
+            for (int i = 0; i < n; i++)
+                printResult(&graphs[i]);
+            n = 0;
+        }
+    }
+    if (ferror(in))
+        error_exit("Failed to read graph file");
+
+    free(line);
+    free(graphs);
+    if (in != stdin)
+        fclose(in);
+    exit(EXIT_SUCCESS);
+}
+
+
+static void usage(void) {
+    fprintf(stderr, "Usage: %s [FILE]\n"
+        "\tFILE: one graph per line, edges U-V with U and V below %d (default: stdin)\n", myprog, TINY_NODES);
+    exit(EXIT_FAILURE);
+}
+
+static int parseLine(char *line, tiny_t *g) {
+    memset(g, 0, sizeof(*g));
+    for (char *tok = strtok(line, " \t\r\n"); tok != NULL; tok = strtok(NULL, " \t\r\n")) {
+        char *ptrU, *ptrV;
+        errno = 0;
+        const long U = strtol(tok, &ptrU, 10);
+        if (ptrU == tok || *ptrU != '-')
+            return -1;
+        const long V = strtol(ptrU + 1, &ptrV, 10);
+        if (ptrV == ptrU + 1 || *ptrV != '\0' || errno != 0 || U < 0 || V < 0 || U >= TINY_NODES || V >= TINY_NODES)
+            return -1;
+
+        if (U == V)
+            g->loops |= 1u << U;
+        else {
+            g->adj[U] |= 1u << V;
+            g->adj[V] |= 1u << U;
+        }
+        if (U + 1 > g->nodeN)
+            g->nodeN = U + 1;
+        if (V + 1 > g->nodeN)
+            g->nodeN = V + 1;
+    }
+    return 0;
+}
+
+static void printResult(const tiny_t *g) {
+    int loopN = 0;
+    for (int v = 0; v < g->nodeN; v++)
+        loopN += g->loops >> v & 1;
+    const int COST = g->conflicts + loopN;
+    if (COST == 0) {
+        printf("The graph is 3-colorable!\n");
+        return;
+    }
+
+    printf("Solution with %d edges:", COST);
+    for (int v = 0; v < g->nodeN; v++) {
+        if (g->loops >> v & 1)
+            printf(" %d-%d", v, v);
+    }
+    for (int u = 0; u < g->nodeN; u++) {
+        for (int v = u + 1; v < g->nodeN; v++) {
+            if ((g->adj[u] >> v & 1) && g->colors[u] == g->colors[v])
+                printf(" %d-%d", u, v);
+        }
+    }
+    printf("\n");
+}
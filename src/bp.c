@@ -0,0 +1,337 @@
+/**
+ * @file bp.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A belief propagation engine with decimation for large sparse graphs.
+ */
+
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include "localsearch.h"
+#include "parallel.h"
+#include "bp.h"
+
+#define PENALTY             0.99f   /**< The weight of a conflicting edge. Below 1 no marginal vanishes. */
+#define DAMPING             0.5f    /**< The share of the old message kept by an update. */
+#define BP_ITER             100     /**< The maximum number of sweeps per decimation round. */
+#define BP_TOL              1e-3f   /**< The largest message change at which the sweeps stop. */
+#define DECIMATE_DIV        32      /**< A decimation round fixes nodeN / DECIMATE_DIV nodes. */
+#define PARAMAGNETIC        0.05f   /**< Marginals with a smaller bias carry no information. */
+#define BIAS_BUCKETS        1024    /**< The number of buckets for selecting the most biased nodes. */
+#define NODES_PER_THREAD    4096    /**< The minimum number of nodes which justify another thread. */
+#define LS_ITER             2000    /**< The number of tabu search iterations between two reports. */
+#define LS_ROUNDS           50      /**< The number of tabu searches which repair a decimated coloring. */
+
+typedef struct bp {         /**< The state of the message passing. */
+    const graph_t *graph;   /**< The graph. */
+    int *rev;               /**< The half-edge in the opposite direction of each half-edge. */
+    float *msg;             /**< msg[h*COLORS+c] is the message from adj[h] to the owner of h about color c. */
+    float *next;            /**< The messages of the next sweep. */
+    float *field;           /**< field[v*COLORS+c] is the log of the unnormalized marginal of v for color c. */
+    char *fixed;            /**< The color each node is fixed to or COLORS. */
+    float change[MAX_THREADS];  /**< The largest message change of each thread in the last sweep. */
+} bp_t;
+
+/**
+ * @brief Allocate the message passing state and pair the half-edges.
+ *
+ * @param b The state.
+ * @param g The graph.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int initPropagation(bp_t *b, const graph_t *g);
+
+/**
+ * @brief Free the message passing state.
+ *
+ * @param b The state.
+ */
+static void freePropagation(bp_t *b);
+
+/**
+ * @brief Draw random messages and unfix all nodes.
+ *
+ * @param b The state.
+ */
+static void resetMessages(bp_t *b);
+
+/**
+ * @brief Compute the fields and the damped outgoing messages of a node range into the next sweep. Implements range_fn.
+ *
+ * @details The message to a neighbor is the field with the factor of the neighbor divided out, so every incoming
+ * message costs one logarithm per color. A fixed node sends a hard message for its color. Every outgoing message has
+ * exactly one sender, so the ranges write disjoint parts of the next sweep.
+ *
+ * @param arg       The bp_t.
+ * @param from      The first node.
+ * @param to        The node after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void updateMessages(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Run parallel sweeps until the messages converge or BP_ITER sweeps are done.
+ *
+ * @param b The state.
+ */
+static void propagate(bp_t *b);
+
+/**
+ * @brief Find the most likely color of a node from its field and the bias of its marginal.
+ *
+ * @details Ties are broken at random.
+ *
+ * @param field The field of the node.
+ * @param bias  The address where the difference of the two largest marginals should be stored.
+ * @return Returns the color.
+ */
+static int likeliestColor(const float *field, float *bias);
+
+/**
+ * @brief Fix the nodeN / DECIMATE_DIV unfixed nodes with the most biased marginals to their most likely colors.
+ *
+ * @details The nodes are selected through a histogram of the biases in O(V).
+ *
+ * @param b     The state.
+ * @param bias  The scratch buffer for the bias of each node.
+ * @param color The scratch buffer for the most likely color of each node.
+ * @return Returns the number of fixed nodes, 0 if no unfixed node has a bias of at least PARAMAGNETIC.
+ */
+static int decimate(bp_t *b, float *bias, char *color);
+
+
+int propagationSearch(const graph_t *g, report_fn report) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    bp_t b;
+    search_t s;
+    if (initPropagation(&b, g) < 0)
+        return -1;
+    if (initSearch(&s, g, 0) < 0) {
+        freePropagation(&b);
+        return -1;
+    }
+    float *bias = malloc(N * sizeof(float));
+    char *best = malloc(N);
+    if (bias == NULL || best == NULL) {
+        free(bias);
+        free(best);
+        freeSearch(&s);
+        freePropagation(&b);
+        return -1;
+    }
+
+    long record = LONG_MAX;
+    int quit = 0;
+    while (quit == 0) {
+        resetMessages(&b);
+        do {
+            propagate(&b);
+            quit = report(NULL);
+        } while (quit == 0 && decimate(&b, bias, s.colors) > 0);
+        if (quit != 0)
+            break;
+
+        for (int v = 0; v < g->nodeN; v++) {
+            if (b.fixed[v] != COLORS)
+                s.colors[v] = b.fixed[v];
+        }
+        loadColoring(&s, s.colors);
+        long cost = s.conflicts;
+        memcpy(best, s.colors, g->nodeN);
+
+        for (int round = 0; quit == 0 && round <= LS_ROUNDS; round++) {
+            if (cost < record) {
+                record = cost;
+                quit = report(best);
+            } else
+                quit = report(NULL);
+            if (cost == 0)
+                break;
+            const long NEXT = tabuSearch(&s, LS_ITER, best);
+            if (NEXT < cost)
+                cost = NEXT;
+        }
+    }
+
+    free(bias);
+    free(best);
+    freeSearch(&s);
+    freePropagation(&b);
+    return 0;
+}
+
+
+static int initPropagation(bp_t *b, const graph_t *g) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    const size_t H = g->offset[g->nodeN] > 0 ? g->offset[g->nodeN] : 1;
+    b->graph = g;
+    b->rev = malloc(H * sizeof(int));
+    b->msg = malloc(H * COLORS * sizeof(float));
+    b->next = malloc(H * COLORS * sizeof(float));
+    b->field = malloc((size_t) N * COLORS * sizeof(float));
+    b->fixed = malloc(N);
+    int *first = malloc((g->edgeN > 0 ? g->edgeN : 1) * sizeof(int));
+    if (b->rev == NULL || b->msg == NULL || b->next == NULL || b->field == NULL || b->fixed == NULL || first == NULL) {
+        free(first);
+        freePropagation(b);
+        return -1;
+    }
+
+    for (int e = 0; e < g->edgeN; e++)
+        first[e] = -1;
+    for (int h = 0; h < g->offset[g->nodeN]; h++) {
+        const int E = g->adjEdge[h];
+        if (first[E] < 0)
+            first[E] = h;
+        else {
+            b->rev[h] = first[E];
+            b->rev[first[E]] = h;
+        }
+    }
+    free(first);
+    return 0;
+}
+
+static void freePropagation(bp_t *b) {
+    free(b->rev);
+    free(b->msg);
+    free(b->next);
+    free(b->field);
+    free(b->fixed);
+}
+
+static void resetMessages(bp_t *b) {
+    const graph_t *g = b->graph;
+    for (int h = 0; h < g->offset[g->nodeN]; h++) {
+        float *m = &b->msg[h * COLORS], sum = 0;
+        for (int c = 0; c < COLORS; c++) {
+            m[c] = 1.0f + (float) random() / RAND_MAX;
+            sum += m[c];
+        }
+        for (int c = 0; c < COLORS; c++)
+            m[c] /= sum;
+    }
+    memset(b->fixed, COLORS, g->nodeN);
+}
+
+static void updateMessages(void *arg, int from, int to, int thread) {
+    bp_t *b = arg;
+    const graph_t *g = b->graph;
+    float change = 0;
+    for (int v = from; v < to; v++) {
+        float *f = &b->field[v * COLORS], top = -HUGE_VALF, belief[COLORS];
+        for (int c = 0; c < COLORS; c++)
+            f[c] = 0;
+        for (int h = g->offset[v]; h < g->offset[v+1]; h++) {
+            for (int c = 0; c < COLORS; c++)
+                f[c] += logf(1.0f - PENALTY * b->msg[h * COLORS + c]);
+        }
+        for (int c = 0; c < COLORS; c++) {
+            if (f[c] > top)
+                top = f[c];
+        }
+        for (int c = 0; c < COLORS; c++) {
+            if (b->fixed[v] != COLORS)
+                belief[c] = c == b->fixed[v];
+            else
+                belief[c] = expf(f[c] - top);
+        }
+
+        for (int h = g->offset[v]; h < g->offset[v+1]; h++) {
+            const int OUT = b->rev[h] * COLORS;
+            float m[COLORS], sum = 0;
+            for (int c = 0; c < COLORS; c++) {
+                m[c] = b->fixed[v] != COLORS ? belief[c] : belief[c] / (1.0f - PENALTY * b->msg[h * COLORS + c]);
+                sum += m[c];
+            }
+            for (int c = 0; c < COLORS; c++) {
+                const float OLD = b->msg[OUT + c];
+                b->next[OUT + c] = DAMPING * OLD + (1.0f - DAMPING) * m[c] / sum;
+                if (fabsf(b->next[OUT + c] - OLD) > change)
+                    change = fabsf(b->next[OUT + c] - OLD);
+            }
+        }
+    }
+    b->change[thread] = change;
+}
+
+static void propagate(bp_t *b) {
+    const int N = b->graph->nodeN;
+    for (int it = 0; it < BP_ITER; it++) {
+        memset(b->change, 0, sizeof(b->change));
+        parallelFor(N, NODES_PER_THREAD, updateMessages, b);
+        float *swap = b->msg;
+        b->msg = b->next;
+        b->next = swap;
+
+        float change = 0;
+        for (int t = 0; t < MAX_THREADS; t++) {
+            if (b->change[t] > change)
+                change = b->change[t];
+        }
+        if (change < BP_TOL)
+            break;
+    }
+}
+
+static int likeliestColor(const float *field, float *bias) {
+    float top = -HUGE_VALF, p[COLORS], sum = 0;
+    for (int c = 0; c < COLORS; c++) {
+        if (field[c] > top)
+            top = field[c];
+    }
+    for (int c = 0; c < COLORS; c++) {
+        p[c] = expf(field[c] - top);
+        sum += p[c];
+    }
+
+    const int START = random() % COLORS;
+    int color = START;
+    float first = -1, second = -1;
+    for (int i = 0; i < COLORS; i++) {
+        const int C = (START + i) % COLORS;
+        if (p[C] > first) {
+            second = first;
+            first = p[C];
+            color = C;
+        } else if (p[C] > second)
+            second = p[C];
+    }
+    *bias = (first - second) / sum;
+    return color;
+}
+
+static int decimate(bp_t *b, float *bias, char *color) {
+    const int N = b->graph->nodeN;
+    int hist[BIAS_BUCKETS + 1], open = 0;
+    memset(hist, 0, sizeof(hist));
+    for (int v = 0; v < N; v++) {
+        color[v] = likeliestColor(&b->field[v * COLORS], &bias[v]);
+        if (b->fixed[v] != COLORS || bias[v] < PARAMAGNETIC)
+            continue;
+        hist[(int) (bias[v] * BIAS_BUCKETS)]++;
+        open++;
+    }
+    if (open == 0)
+        return 0;
+
+    int quota = N / DECIMATE_DIV > 0 ? N / DECIMATE_DIV : 1, cut = BIAS_BUCKETS;
+    if (quota > open)
+        quota = open;
+    for (int taken = hist[cut]; taken < quota; taken += hist[cut])
+        cut--;
+
+    int fixedN = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int v = 0; v < N && fixedN < quota; v++) {
+            const int BUCKET = (int) (bias[v] * BIAS_BUCKETS);
+            if (b->fixed[v] != COLORS || bias[v] < PARAMAGNETIC || BUCKET < cut || (pass == 0 && BUCKET == cut))
+                continue;
+            b->fixed[v] = color[v];
+            fixedN++;
+        }
+    }
+    return fixedN;
+}
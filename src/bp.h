@@ -0,0 +1,30 @@
+/**
+ * @file bp.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A belief propagation engine with decimation for large sparse graphs.
+ *
+ * @details Every half-edge of the CSR graph carries a message with one probability per color: the belief of the
+ * neighbor about its own color while ignoring the receiving node. The messages live in one flat array indexed by
+ * half-edge and are updated in damped parallel sweeps over row ranges of the graph until they converge. The nodes
+ * with the most biased marginals are then fixed to their most likely color, after which they send hard messages,
+ * and the propagation continues on the simplified graph. Once all nodes are fixed or the marginals carry no more
+ * information, the coloring is completed from the marginals and the residual conflicts are repaired by tabu search.
+ * The memory is linear in the number of edges, so the engine scales to millions of nodes.
+ */
+
+#pragma once
+#include "graph.h"
+
+/**
+ * @brief Run belief propagation with decimation until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback. Each
+ * restart draws fresh random messages.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int propagationSearch(const graph_t *g, report_fn report);
@@ -0,0 +1,448 @@
+/**
+ * @file chromatic.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A search for the chromatic number which tightens a proven lower and upper bound until they meet.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "localsearch.h"
+#include "csp.h"
+#include "chromatic.h"
+
+static bounds_fn pollTarget;    /**< The callback which pollBounds() forwards to. */
+
+/**
+ * @brief Order the nodes by repeatedly removing one of least remaining degree (Batagelj and Zaversnik).
+ *
+ * @param g     The graph.
+ * @param order The buffer where the nodes should be stored in the order of their removal.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int degeneracyOrder(const graph_t *g, int *order);
+
+/**
+ * @brief Color the nodes greedily in reverse removal order, each with the smallest color none of its neighbors has.
+ *
+ * @param g         The graph.
+ * @param order     The nodes in the order of their removal.
+ * @param colors    The buffer where the coloring should be stored.
+ * @return Returns the number of colors or -1 if memory could not be allocated.
+ */
+static int greedyColoring(const graph_t *g, const int *order, int *colors);
+
+/**
+ * @brief Grow a clique greedily from the removed nodes in reverse order until CLIQUE_WORK half-edges were visited.
+ *
+ * @details The clique is extended by the common neighbor with the most other common neighbors until no common
+ * neighbor is left.
+ *
+ * @param g     The graph.
+ * @param order The nodes in the order of their removal.
+ * @return Returns the size of the largest clique or -1 if memory could not be allocated.
+ */
+static int cliqueBound(const graph_t *g, const int *order);
+
+/**
+ * @brief Color the graph with two colors by a breadth first search.
+ *
+ * @param g         The graph.
+ * @param colors    The buffer where the coloring should be stored. Its content is undefined if the graph has an odd
+ * cycle.
+ * @return Returns 1 if the graph is bipartite, 0 if it is not and -1 if memory could not be allocated.
+ */
+static int twoColoring(const graph_t *g, int *colors);
+
+/**
+ * @brief Merge the smallest color class into the others.
+ *
+ * @details Every node of the class takes the color with the fewest neighbors, and the last color takes the place of
+ * the merged one.
+ *
+ * @param g         The graph.
+ * @param colors    The coloring with colors from 0 to k-1, which is left with colors from 0 to k-2.
+ * @param k         The number of colors.
+ * @param hist      A buffer of at least k entries.
+ */
+static void mergeSmallest(const graph_t *g, int *colors, int k, int *hist);
+
+/**
+ * @brief Renumber the colors in order of their first node so that no color is unused.
+ *
+ * @param colors    The coloring with colors from 0 to k-1.
+ * @param nodeN     The number of nodes.
+ * @param k         The number of colors.
+ * @param hist      A buffer of at least k entries.
+ * @return Returns the number of used colors.
+ */
+static int compactColors(int *colors, int nodeN, int k, int *hist);
+
+/**
+ * @brief Remove the conflicts of a warm started coloring with k colors by a weighted tabu search.
+ *
+ * @details After every ROUND_ITER iterations the weight of every conflicting edge is bumped and the callback is
+ * polled.
+ *
+ * @param g         The graph.
+ * @param k         The number of colors.
+ * @param colors    The warm start with colors from 0 to k-1, replaced by the proper coloring if one was found.
+ * @param weight    The edge weights, which are used and updated by the search.
+ * @param report    The callback which is polled for termination.
+ * @return Returns 1 if a proper coloring was found, 0 if the callback ended the search and -1 if memory could not be
+ * allocated.
+ */
+static int solveColors(const graph_t *g, int k, int *colors, int *weight, bounds_fn report);
+
+/**
+ * @brief Bump the weight of every conflicting edge of the current coloring.
+ *
+ * @param s The weighted search state.
+ */
+static void bumpConflicts(search_t *s);
+
+/**
+ * @brief Poll the bounds callback for termination. Implements report_fn.
+ *
+ * @details Global variables: pollTarget.
+ *
+ * @param colors    Ignored.
+ * @return Returns non-zero if the search should stop.
+ */
+static int pollBounds(const char *colors);
+
+
+int chromaticSearch(const graph_t *g, bounds_fn report) {
+    const int N = g->nodeN;
+    if (g->edgeN == 0) {
+        report(1, 1);
+        return 0;
+    }
+
+    int *order = malloc(N * sizeof(int)), *colors = malloc(N * sizeof(int)), *hist = malloc((N + 1) * sizeof(int));
+    int *weight = malloc(g->edgeN * sizeof(int));
+    char *buf = malloc(N);
+    int status = order != NULL && colors != NULL && hist != NULL && weight != NULL && buf != NULL ? 0 : -1;
+    int lower = 0, upper = 0, quit = 0;
+    if (status == 0)
+        status = degeneracyOrder(g, order);
+    if (status == 0) {
+        const int BIPARTITE = twoColoring(g, colors);
+        if (BIPARTITE == 1)
+            lower = upper = 2;
+        else if (BIPARTITE == 0) {
+            upper = greedyColoring(g, order, colors);
+            lower = cliqueBound(g, order);
+            if (lower >= 0 && lower < 3)
+                lower = 3;
+        }
+        status = BIPARTITE < 0 || upper < 0 || lower < 0 ? -1 : 0;
+    }
+    if (status == 0)
+        quit = report(lower, upper);
+
+    // The exact decision settles 3 colors if the core is small enough
+    if (status == 0 && quit == 0 && lower == 3 && upper > 3) {
+        pollTarget = report;
+        const int FOUND = decideColoring(g, pollBounds, buf);
+        if (FOUND == 1) {
+            for (int v = 0; v < N; v++)
+                colors[v] = buf[v];
+            upper = 3;
+        } else if (FOUND == 0)
+            lower = 4;
+        if (FOUND == 1 || FOUND == 0)
+            quit = report(lower, upper);
+        else if (FOUND == -1)
+            quit = 1;
+        else if (FOUND == -3)
+            status = -1;
+    }
+
+    for (int i = 0; i < g->edgeN && status == 0; i++)
+        weight[i] = 1;
+    while (status == 0 && quit == 0 && upper > lower && lower <= MAX_COLORS) {
+        const int K = upper - 1 < MAX_COLORS ? upper - 1 : MAX_COLORS;
+        for (int k = upper; k > K; k--)
+            mergeSmallest(g, colors, k, hist);
+        const int FOUND = solveColors(g, K, colors, weight, report);
+        if (FOUND == 1) {
+            upper = compactColors(colors, N, K, hist);
+            quit = report(lower, upper);
+        } else if (FOUND == 0)
+            quit = 1;
+        else
+            status = -1;
+    }
+
+    free(order);
+    free(colors);
+    free(hist);
+    free(weight);
+    free(buf);
+    return status;
+}
+
+
+static int degeneracyOrder(const graph_t *g, int *order) {
+    const int N = g->nodeN;
+    int maxDeg = 0;
+    for (int v = 0; v < N; v++) {
+        if (g->offset[v+1] - g->offset[v] > maxDeg)
+            maxDeg = g->offset[v+1] - g->offset[v];
+    }
+    int *deg = malloc(N * sizeof(int)), *pos = malloc(N * sizeof(int)), *bin = calloc(maxDeg + 1, sizeof(int));
+    if (deg == NULL || pos == NULL || bin == NULL) {
+        free(deg);
+        free(pos);
+        free(bin);
+        return -1;
+    }
+
+    // Sort the nodes by degree, bin[d] is the index of the first node of degree d
+    for (int v = 0; v < N; v++) {
+        deg[v] = g->offset[v+1] - g->offset[v];
+        bin[deg[v]]++;
+    }
+    for (int d = 0, start = 0; d <= maxDeg; d++) {
+        const int COUNT = bin[d];
+        bin[d] = start;
+        start += COUNT;
+    }
+    for (int v = 0; v < N; v++) {
+        pos[v] = bin[deg[v]]++;
+        order[pos[v]] = v;
+    }
+    for (int d = maxDeg; d > 0; d--)
+        bin[d] = bin[d-1];
+    bin[0] = 0;
+
+    // Removing a node moves each neighbor of larger remaining degree to the front of its bin, which then shrinks
+    for (int i = 0; i < N; i++) {
+        const int V = order[i];
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+            const int U = g->adj[h];
+            if (deg[U] <= deg[V])
+                continue;
+            const int FIRST = bin[deg[U]], W = order[FIRST];
+            if (U != W) {
+                order[pos[U]] = W;
+                pos[W] = pos[U];
+                order[FIRST] = U;
+                pos[U] = FIRST;
+            }
+            bin[deg[U]]++;
+            deg[U]--;
+        }
+    }
+
+    free(deg);
+    free(pos);
+    free(bin);
+    return 0;
+}
+
+static int greedyColoring(const graph_t *g, const int *order, int *colors) {
+    const int N = g->nodeN;
+    int *seen = malloc((N + 1) * sizeof(int));
+    if (seen == NULL)
+        return -1;
+    for (int v = 0; v < N; v++) {
+        colors[v] = -1;
+        seen[v] = -1;
+    }
+    seen[N] = -1;
+
+    int k = 0;
+    for (int i = N - 1; i >= 0; i--) {
+        const int V = order[i];
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+            if (colors[g->adj[h]] >= 0)
+                seen[colors[g->adj[h]]] = V;
+        }
+        int c = 0;
+        while (seen[c] == V)
+            c++;
+        colors[V] = c;
+        if (c >= k)
+            k = c + 1;
+    }
+
+    free(seen);
+    return k;
+}
+
+static int cliqueBound(const graph_t *g, const int *order) {
+    const int N = g->nodeN;
+    int *cand = malloc(N * sizeof(int));
+    unsigned int *mark = calloc(N, sizeof(unsigned int));
+    if (cand == NULL || mark == NULL) {
+        free(cand);
+        free(mark);
+        return -1;
+    }
+
+    int best = 1;
+    long work = 0;
+    unsigned int stamp = 0;
+    for (int s = 0; s < N && work < CLIQUE_WORK; s++) {
+        const int V = order[N-1-s];
+        int candN = 0, size = 1;
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++)
+            cand[candN++] = g->adj[h];
+
+        while (candN > 0) {
+            stamp++;
+            for (int i = 0; i < candN; i++)
+                mark[cand[i]] = stamp;
+            int u = cand[0], most = -1;
+            for (int i = 0; i < candN; i++) {
+                int inside = 0;
+                for (int h = g->offset[cand[i]]; h < g->offset[cand[i]+1]; h++)
+                    inside += mark[g->adj[h]] == stamp;
+                work += g->offset[cand[i]+1] - g->offset[cand[i]];
+                if (inside > most) {
+                    most = inside;
+                    u = cand[i];
+                }
+            }
+            size++;
+            stamp++;
+            for (int h = g->offset[u]; h < g->offset[u+1]; h++)
+                mark[g->adj[h]] = stamp;
+            int kept = 0;
+            for (int i = 0; i < candN; i++) {
+                if (mark[cand[i]] == stamp)
+                    cand[kept++] = cand[i];
+            }
+            candN = kept;
+        }
+        if (size > best)
+            best = size;
+    }
+
+    free(cand);
+    free(mark);
+    return best;
+}
+
+static int twoColoring(const graph_t *g, int *colors) {
+    const int N = g->nodeN;
+    int *queue = malloc(N * sizeof(int));
+    if (queue == NULL)
+        return -1;
+    for (int v = 0; v < N; v++)
+        colors[v] = -1;
+
+    for (int s = 0; s < N; s++) {
+        if (colors[s] >= 0)
+            continue;
+        int head = 0, tail = 0;
+        colors[s] = 0;
+        queue[tail++] = s;
+        while (head < tail) {
+            const int V = queue[head++];
+            for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+                const int U = g->adj[h];
+                if (colors[U] < 0) {
+                    colors[U] = 1 - colors[V];
+                    queue[tail++] = U;
+                } else if (colors[U] == colors[V]) {
+                    free(queue);
+                    return 0;
+                }
+            }
+        }
+    }
+
+    free(queue);
+    return 1;
+}
+
+static void mergeSmallest(const graph_t *g, int *colors, int k, int *hist) {
+    const int N = g->nodeN;
+    memset(hist, 0, k * sizeof(int));
+    for (int v = 0; v < N; v++)
+        hist[colors[v]]++;
+    int m = 0;
+    for (int c = 1; c < k; c++) {
+        if (hist[c] < hist[m])
+            m = c;
+    }
+
+    for (int v = 0; v < N; v++) {
+        if (colors[v] != m)
+            continue;
+        memset(hist, 0, k * sizeof(int));
+        for (int h = g->offset[v]; h < g->offset[v+1]; h++)
+            hist[colors[g->adj[h]]]++;
+        int best = m == 0 ? 1 : 0;
+        for (int c = 0; c < k; c++) {
+            if (c != m && hist[c] < hist[best])
+                best = c;
+        }
+        colors[v] = best;
+    }
+    for (int v = 0; v < N; v++) {
+        if (colors[v] == k - 1)
+            colors[v] = m;
+    }
+}
+
+static int compactColors(int *colors, int nodeN, int k, int *hist) {
+    for (int c = 0; c < k; c++)
+        hist[c] = -1;
+    int used = 0;
+    for (int v = 0; v < nodeN; v++) {
+        if (hist[colors[v]] < 0)
+            hist[colors[v]] = used++;
+        colors[v] = hist[colors[v]];
+    }
+    return used;
+}
+
+static int solveColors(const graph_t *g, int k, int *colors, int *weight, bounds_fn report) {
+    setColorCount(k);
+    search_t s;
+    char *best = malloc(g->nodeN);
+    if (best == NULL || initSearch(&s, g, 1) < 0) {
+        free(best);
+        return -1;
+    }
+    memcpy(s.weight, weight, g->edgeN * sizeof(int));
+    for (int v = 0; v < g->nodeN; v++)
+        best[v] = colors[v];
+    loadColoring(&s, best);
+
+    int found = 0, quit = 0;
+    while (found == 0 && quit == 0) {
+        found = tabuSearch(&s, ROUND_ITER, best) == 0;
+        if (found == 0) {
+            bumpConflicts(&s);
+            quit = report(0, 0);
+        }
+    }
+    for (int v = 0; v < g->nodeN && found; v++)
+        colors[v] = best[v];
+    memcpy(weight, s.weight, g->edgeN * sizeof(int));
+
+    freeSearch(&s);
+    free(best);
+    return found;
+}
+
+static void bumpConflicts(search_t *s) {
+    const graph_t *g = s->graph;
+    for (int i = 0; i < s->confN; i++) {
+        const int V = s->confList[i];
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+            if (g->adj[h] > V && s->colors[g->adj[h]] == s->colors[V])
+                addWeight(s, g->adjEdge[h], 1);
+        }
+    }
+}
+
+static int pollBounds(const char *colors) {
+    return pollTarget(0, 0);
+}
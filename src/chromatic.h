@@ -0,0 +1,44 @@
+/**
+ * @file chromatic.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A search for the chromatic number which tightens a proven lower and upper bound until they meet.
+ *
+ * @details The upper bound starts from a greedy coloring in smallest last order, whose removal order is the
+ * degeneracy order of the graph. The lower bound starts from the largest of the cliques grown greedily from the
+ * nodes removed last, as many as a fixed budget of work allows, raised to 3 if the graph has an odd cycle. A
+ * bipartite graph is decided right away, and a core of at most CSP_NODES nodes is decided for 3 colors exactly.
+ * Afterwards k is decreased one by one, never below the lower bound and starting at MAX_COLORS at most, so a lower
+ * bound above MAX_COLORS ends the search with the greedy bounds. The coloring with k+1 colors is the warm start for
+ * k: the smallest color class is merged into the others, each of its nodes taking the color with the fewest
+ * neighbors, and a weighted tabu search removes the remaining conflicts. The edge weights which the breakout bumps
+ * learned at k+1 are kept for k, since the edges which were hard to satisfy with more colors stay hard with less.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define CLIQUE_WORK     (1L << 26)  /**< The number of half-edges the clique search visits at most. */
+#define ROUND_ITER      10000       /**< The number of tabu search iterations between two weight bumps. */
+
+/**
+ * @brief The callback through which the search hands its bounds to the generator.
+ *
+ * @param lower The proven lower bound on the chromatic number, or 0 to only poll.
+ * @param upper The number of colors of a proper coloring which was found, or 0 to only poll.
+ * @return Returns non-zero if the search should stop.
+ */
+typedef int (*bounds_fn)(int lower, int upper);
+
+/**
+ * @brief Tighten the bounds on the chromatic number until they meet or the callback requests termination.
+ *
+ * @details The graph must not have parallel edges and its self-loops must have been removed. The bounds are reported
+ * whenever one of them tightens, which includes the first report of both.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting the bounds.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int chromaticSearch(const graph_t *g, bounds_fn report);
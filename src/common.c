@@ -8,6 +8,14 @@
 
 #include "common.h"
 
+sem_t *sem_free;
+sem_t *sem_used;
+sem_t *sem_mutex;
+sem_t *sem_pool;
+myshm_t *myshm;
+int shmfd;
+char *myprog;
+
 void print_error(const char *msg) {
     fprintf(stderr, "Error in %s: %s\n", myprog, msg);
     if (errno != 0)
@@ -44,4 +52,9 @@ void closeSemFree(void) {
 void closeSemMutex(void) {
     if (sem_close(sem_mutex) == -1)
         print_error("Failed to close /01528992_3col_mutex");
+}
+
+void closeSemPool(void) {
+    if (sem_close(sem_pool) == -1)
+        print_error("Failed to close " SEM_POOL);
 }
\ No newline at end of file
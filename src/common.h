@@ -23,22 +23,50 @@
 #define SEM_FREE    "/3col_free"
 #define SEM_USED    "/3col_used"
 #define SEM_MUTEX   "/3col_mutex"
+#define SEM_POOL    "/3col_pool"
 #define BUF_LEN     64
 #define MAX_LINE    50
+#define WEIGHT_LEN  65536               /**< The number of shared edge weight slots. */
+#define SMOOTH_PERIOD 4096              /**< The number of weight bumps after which the shared weights are smoothed. */
+#define POOL_LEN    16                  /**< The capacity of the elite pool. */
+#define POOL_NODES  4096                /**< The maximum number of nodes of a coloring in the elite pool. */
 
 
+typedef struct solution {               /**< An entry of the circular buffer. */
+    int cost;                           /**< The number of removed edges or -1 if only a bound is sent. */
+    int forced;                         /**< The number of self-loops among them, which every solution removes. */
+    int bound;                          /**< A proven lower bound on the removed edges of every solution, or 0. */
+    int colors;                         /**< The number of colors of the coloring. */
+    int lowerColors;                    /**< A proven lower bound on the chromatic number, or 0. */
+    int upperColors;                    /**< The number of colors of a proper coloring which was found, or 0. */
+    int nodeN;                          /**< The number of nodes of the attached coloring or 0 if there is none. */
+    char edges[MAX_LINE];               /**< The removed edges or an empty string if they didn't fit. */
+    char coloring[POOL_NODES];          /**< The coloring which should be offered to the elite pool. */
+} solution_t;
+
+typedef struct pool {                   /**< The elite pool of the evolutionary search. Guarded by SEM_POOL. */
+    int size;                           /**< The number of colorings in the pool. */
+    int nodeN;                          /**< The number of nodes of the pooled colorings. */
+    int cost[POOL_LEN];                 /**< The number of conflicting edges of each coloring. */
+    char coloring[POOL_LEN][POOL_NODES];/**< The pooled colorings. */
+} pool_t;
+
 typedef struct myshm {                  /**< The shared memory. */
     int state;                          /**< The state flag. If state not equals 0 all generators should terminate. */
     int write_pos;                      /**< The index at which the generators should write to the circular buffer. */
-    char shm_buf[BUF_LEN][MAX_LINE];    /**< The circular buffer. */
+    solution_t shm_buf[BUF_LEN];        /**< The circular buffer. */
+    pool_t pool;                        /**< The elite pool which is maintained by the supervisor. */
+    unsigned int weight_bumps;          /**< The total number of weight bumps. Updated with relaxed atomics. */
+    unsigned int weight[WEIGHT_LEN];    /**< The extra weight of the edges hashed to each slot. Updated atomically. */
 } myshm_t;
 
-sem_t *sem_free;                        /**< The semaphore indicating the free space in the circular buffer. */
-sem_t *sem_used;                        /**< The semaphore indicating the used space in the circular buffer. */
-sem_t *sem_mutex;                       /**< The semaphore for mutual exclusion. */
-myshm_t *myshm;                         /**< A pointer to the shared memory. */
-int shmfd;                              /**< The file descriptor to the shared memory. */
-char *myprog;                           /**< The program name. */
+extern sem_t *sem_free;                 /**< The semaphore indicating the free space in the circular buffer. */
+extern sem_t *sem_used;                 /**< The semaphore indicating the used space in the circular buffer. */
+extern sem_t *sem_mutex;                /**< The semaphore for mutual exclusion. */
+extern sem_t *sem_pool;                 /**< The semaphore for mutual exclusion on the elite pool. */
+extern myshm_t *myshm;                  /**< A pointer to the shared memory. */
+extern int shmfd;                       /**< The file descriptor to the shared memory. */
+extern char *myprog;                    /**< The program name. */
 
 /**
  * @brief Print error to stderr.
@@ -90,4 +118,11 @@ void closeSemFree(void);
  * 
  * @details Global variables: sem_mutex.
  */
-void closeSemMutex(void);
\ No newline at end of file
+void closeSemMutex(void);
+
+/**
+ * @brief Close the semaphore for mutual exclusion on the elite pool.
+ * 
+ * @details Global variables: sem_pool.
+ */
+void closeSemPool(void);
\ No newline at end of file
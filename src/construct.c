@@ -0,0 +1,236 @@
+/**
+ * @file construct.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief The constructions which produce the start colorings of the search engines.
+ */
+
+#include <string.h>
+#include "localsearch.h"
+#include "spectral.h"
+#include "construct.h"
+
+#define RCL_SLACK   0   /**< Colors with at most this many conflicts above the least conflicting one are candidates. */
+
+// Global variables
+static enum construction construction = CONSTRUCT_RANDOM;  /**< The selected construction. */
+static const graph_t *embedded;                             /**< The graph whose embedding is cached. */
+static double *embedding;                                   /**< The cached spectral embedding. */
+
+/**
+ * @brief Order the nodes randomly with a bias towards high degrees.
+ *
+ * @details Every node gets the key deg + random() % (deg + 1) and the nodes are counting sorted by descending key,
+ * so the order costs O(V + maximum degree).
+ *
+ * @param g     The graph.
+ * @param order The buffer where the order should be stored.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int degreeOrder(const graph_t *g, int *order);
+
+/**
+ * @brief Pick a random color out of a domain.
+ *
+ * @param domain    The non-empty bitmask of colors.
+ * @param k         The number of colors.
+ * @return Returns the color.
+ */
+static int pickColor(unsigned char domain, int k);
+
+/**
+ * @brief Pick the color with the least colored neighbors, breaking ties at random.
+ *
+ * @param hist  The neighbor color histogram of the node.
+ * @param k     The number of colors.
+ * @return Returns the color.
+ */
+static int leastConflicting(const int *hist, int k);
+
+
+void setConstruction(enum construction method) {
+    construction = method;
+}
+
+enum construction getConstruction(void) {
+    return construction;
+}
+
+void initialColoring(const graph_t *g, char *colors) {
+    if (construction == CONSTRUCT_GRASP && graspColoring(g, colors) == 0)
+        return;
+    if (construction == CONSTRUCT_PROP && propagateColoring(g, colors) >= 0)
+        return;
+    if (construction == CONSTRUCT_SPECTRAL && getColorCount() == COLORS) {
+        if (embedded != g) {
+            free(embedding);
+            embedded = NULL;
+            embedding = malloc(((size_t) g->nodeN * EMBED_DIM + 1) * sizeof(double));
+            if (embedding != NULL && spectralEmbedding(g, embedding) == 0)
+                embedded = g;
+        }
+        if (embedded == g) {
+            clusterColoring(embedding, g->nodeN, colors);
+            return;
+        }
+    }
+    randomColoring(colors, g->nodeN);
+}
+
+void freeConstruction(void) {
+    free(embedding);
+    embedding = NULL;
+    embedded = NULL;
+}
+
+int graspColoring(const graph_t *g, char *colors) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1, K = getColorCount();
+    int *order = malloc(N * sizeof(int));
+    int *hist = calloc((size_t) N * K, sizeof(int));
+    if (order == NULL || hist == NULL || degreeOrder(g, order) < 0) {
+        free(order);
+        free(hist);
+        return -1;
+    }
+
+    for (int i = 0; i < g->nodeN; i++) {
+        const int V = order[i];
+        const int COLOR = leastConflicting(&hist[V * K], K);
+        colors[V] = COLOR;
+        cursor_t cur;
+        initCursor(&cur, g, V);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;)
+            hist[u * K + COLOR]++;
+    }
+
+    free(order);
+    free(hist);
+    return 0;
+}
+
+int propagateColoring(const graph_t *g, char *colors) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1, K = getColorCount();
+    int *order = malloc(N * sizeof(int));
+    int *queue = malloc((2 * N + 1) * sizeof(int));
+    int *hist = calloc((size_t) N * K, sizeof(int));
+    unsigned char *domain = malloc(N);
+    if (order == NULL || queue == NULL || hist == NULL || domain == NULL || degreeOrder(g, order) < 0) {
+        free(order);
+        free(queue);
+        free(hist);
+        free(domain);
+        return -1;
+    }
+    memset(domain, (1 << K) - 1, g->nodeN);
+    memset(colors, K, g->nodeN);
+
+    int wipeouts = 0;
+    for (int i = 0; i < g->nodeN; i++) {
+        int head = 0, tail = 0;
+        queue[tail++] = order[i];
+        while (head < tail) {
+            const int V = queue[head++];
+            if (colors[V] != K)
+                continue;
+
+            int color;
+            if (domain[V] != 0)
+                color = pickColor(domain[V], K);
+            else {
+                color = leastConflicting(&hist[V * K], K);
+                wipeouts++;
+            }
+            colors[V] = color;
+
+            cursor_t cur;
+            initCursor(&cur, g, V);
+            for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+                const int U = u;
+                hist[U * K + color]++;
+                if (colors[U] != K || (domain[U] & (1 << color)) == 0)
+                    continue;
+                domain[U] &= ~(1 << color);
+                if ((domain[U] & (domain[U] - 1)) == 0)
+                    queue[tail++] = U;
+            }
+        }
+    }
+
+    free(order);
+    free(queue);
+    free(hist);
+    free(domain);
+    return wipeouts;
+}
+
+int constructiveSearch(const graph_t *g, report_fn report) {
+    char *colors = malloc(g->nodeN > 0 ? g->nodeN : 1);
+    if (colors == NULL)
+        return -1;
+
+    int quit = 0;
+    while (quit == 0) {
+        initialColoring(g, colors);
+        quit = report(colors);
+    }
+
+    free(colors);
+    return 0;
+}
+
+
+static int degreeOrder(const graph_t *g, int *order) {
+    int maxKey = 0;
+    for (int v = 0; v < g->nodeN; v++) {
+        const int DEG = g->offset[v+1] - g->offset[v];
+        if (2 * DEG > maxKey)
+            maxKey = 2 * DEG;
+    }
+
+    int *key = malloc((g->nodeN > 0 ? g->nodeN : 1) * sizeof(int));
+    int *bucket = calloc(maxKey + 2, sizeof(int));
+    if (key == NULL || bucket == NULL) {
+        free(key);
+        free(bucket);
+        return -1;
+    }
+
+    for (int v = 0; v < g->nodeN; v++) {
+        const int DEG = g->offset[v+1] - g->offset[v];
+        key[v] = maxKey - (DEG + random() % (DEG + 1));
+        bucket[key[v] + 1]++;
+    }
+    for (int k = 0; k <= maxKey; k++)
+        bucket[k+1] += bucket[k];
+    for (int v = 0; v < g->nodeN; v++)
+        order[bucket[key[v]]++] = v;
+
+    free(key);
+    free(bucket);
+    return 0;
+}
+
+static int pickColor(unsigned char domain, int k) {
+    int candidates = 0, color = 0;
+    for (int c = 0; c < k; c++) {
+        if ((domain & (1 << c)) && random() % ++candidates == 0)
+            color = c;
+    }
+    return color;
+}
+
+static int leastConflicting(const int *hist, int k) {
+    int least = hist[0];
+    for (int c = 1; c < k; c++) {
+        if (hist[c] < least)
+            least = hist[c];
+    }
+
+    int candidates = 0, color = 0;
+    for (int c = 0; c < k; c++) {
+        if (hist[c] <= least + RCL_SLACK && random() % ++candidates == 0)
+            color = c;
+    }
+    return color;
+}
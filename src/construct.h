@@ -0,0 +1,90 @@
+/**
+ * @file construct.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief The constructions which produce the start colorings of the search engines.
+ *
+ * @details The construction is selected once with setConstruction() and then used by every engine whenever it needs
+ * a fresh coloring. Besides uniform random colors there is a greedy randomized construction (GRASP): it visits the
+ * nodes in a random order biased towards high degrees and picks each color from a restricted candidate list of the
+ * least conflicting colors, counted from a per-node histogram of the colors of already colored neighbors. Like a
+ * random pass it costs O(V + E).
+ *
+ * The propagating construction additionally keeps a bitmask of the remaining colors of every node. Coloring a node
+ * removes its color from the masks of its neighbors, and a node whose mask shrinks to a single color is colored
+ * right away through a work queue (unit propagation). A node without remaining colors takes its least conflicting
+ * color. On nearly colorable graphs most nodes are forced this way instead of being guessed.
+ *
+ * The spectral construction clusters the spectral embedding of the graph (see spectral.h). The embedding is computed
+ * on first use and kept, so later constructions only rerun the clustering from a new random seeding. It clusters into
+ * COLORS classes, so with another number of colors random colors are used instead.
+ */
+
+#pragma once
+#include "graph.h"
+
+enum construction {     /**< The available constructions. */
+    CONSTRUCT_RANDOM,   /**< Uniform random colors. */
+    CONSTRUCT_GRASP,    /**< Greedy randomized construction. */
+    CONSTRUCT_PROP,     /**< Greedy randomized construction with unit propagation on color domains. */
+    CONSTRUCT_SPECTRAL  /**< Clustering of the spectral embedding. */
+};
+
+/**
+ * @brief Select the construction used by initialColoring().
+ *
+ * @param method    The construction.
+ */
+void setConstruction(enum construction method);
+
+/**
+ * @brief Get the construction used by initialColoring().
+ *
+ * @return Returns the selected construction.
+ */
+enum construction getConstruction(void);
+
+/**
+ * @brief Construct a coloring with the selected construction.
+ *
+ * @details If the scratch memory of a construction can't be allocated a random coloring is produced instead.
+ *
+ * @param g         The graph.
+ * @param colors    The buffer where the coloring should be stored.
+ */
+void initialColoring(const graph_t *g, char *colors);
+
+/**
+ * @brief Free the spectral embedding cached by initialColoring().
+ */
+void freeConstruction(void);
+
+/**
+ * @brief Construct a coloring with the greedy randomized construction.
+ *
+ * @param g         The graph.
+ * @param colors    The buffer where the coloring should be stored.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int graspColoring(const graph_t *g, char *colors);
+
+/**
+ * @brief Construct a coloring with unit propagation on the color domains.
+ *
+ * @param g         The graph.
+ * @param colors    The buffer where the coloring should be stored.
+ * @return Returns the number of nodes which had no color left on success and -1 if memory could not be allocated.
+ */
+int propagateColoring(const graph_t *g, char *colors);
+
+/**
+ * @brief Submit constructed colorings until the callback requests termination.
+ *
+ * @details This is the search engine of the random mode when a construction other than CONSTRUCT_RANDOM is selected.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int constructiveSearch(const graph_t *g, report_fn report);
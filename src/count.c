@@ -0,0 +1,569 @@
+/**
+ * @file count.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Counting the proper 3-colorings of a graph.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "parallel.h"
+#include "count.h"
+
+#define PEELED              -3          /**< The label of a node which was peeled off the 2-core. */
+#define MARKED              -2          /**< The label of a node of the current component before it is numbered. */
+#define ENTRIES_PER_THREAD  (1 << 14)   /**< The minimum number of table entries which justify another thread. */
+#define LIMBS(i)            (((i) + 33) / 32)   /**< The number of limbs of a count after nodes 0 to i. */
+#define POW3_LIMB           20          /**< The largest exponent of a power of 3 which fits into a limb. */
+
+typedef struct bignum {     /**< An arbitrary precision count. */
+    uint32_t *limb;         /**< The 32 bit limbs, least significant first. */
+    int len;                /**< The number of limbs. */
+} bignum_t;
+
+typedef struct component {  /**< A connected component of the 2-core in breadth-first numbering. */
+    int nodeN;              /**< The number of nodes. */
+    int *offset;            /**< The neighbors of node v are adj[offset[v]] till adj[offset[v+1]-1]. */
+    int *adj;               /**< The neighbors. */
+    int *last;              /**< The highest number among each node and its neighbors. */
+} component_t;
+
+typedef struct pass {           /**< The operands of a step of the dynamic program. */
+    const uint32_t *src;        /**< The input table. */
+    uint32_t *dst;              /**< The output table. */
+    int srcLimbs;               /**< The number of limbs of an input entry. */
+    int dstLimbs;               /**< The number of limbs of an output entry. */
+    int power;                  /**< The input size when adding a node, the place value of the dropped digit else. */
+    int nbrN;                   /**< The number of frontier neighbors of an added node. */
+    int nbrPower[PATH_WIDTH];   /**< The place values of the digits of those neighbors. */
+} pass_t;
+
+typedef struct backtrack {      /**< The state shared by the threads of the backtracking counter. */
+    const component_t *comp;    /**< The component. */
+    int prefixN;                /**< The number of nodes whose colors are fixed by each work item. */
+    int failed;                 /**< Set if a thread could not allocate its buffers. */
+    uint64_t count[MAX_THREADS];/**< The colorings counted by each thread. */
+} backtrack_t;
+
+/**
+ * @brief Number the nodes reachable from a root in breadth-first order.
+ *
+ * @details Only nodes whose label is seen are visited. They get the label MARKED, or their position in the order
+ * if number is set.
+ *
+ * @param g         The graph.
+ * @param root      The root, whose label has to be seen.
+ * @param label     The labels of the nodes.
+ * @param seen      The label of the nodes which should be visited.
+ * @param number    Set if the nodes should be labeled with their position.
+ * @param order     The buffer where the visited nodes should be stored in order.
+ * @return Returns the number of visited nodes.
+ */
+static int breadthFirst(const graph_t *g, int root, int *label, int seen, int number, int *order);
+
+/**
+ * @brief Multiply the count of a component into the total.
+ *
+ * @details Uses the dynamic program if the frontier stays within PATH_WIDTH nodes and the backtracking counter else.
+ *
+ * @param c     The component.
+ * @param total The total count.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int countComponent(component_t *c, bignum_t *total);
+
+/**
+ * @brief Count the colorings of a component with a dynamic program over its frontier.
+ *
+ * @details The two tables are sized by cells, the largest number of limbs of a step.
+ *
+ * @param c     The component, whose last array is filled.
+ * @param cells The number of limbs of the largest table.
+ * @param total The total count the result is multiplied into.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int pathCount(const component_t *c, size_t cells, bignum_t *total);
+
+/**
+ * @brief Compute the largest frontier of a component and the size of the largest table.
+ *
+ * @param c     The component, whose last array is filled.
+ * @param cells The address where the number of limbs of the largest table should be stored.
+ * @return Returns the largest frontier including the added node or PATH_WIDTH + 1 if it exceeds PATH_WIDTH, and -1
+ * if memory could not be allocated.
+ */
+static int pathWidth(component_t *c, size_t *cells);
+
+/**
+ * @brief Extend every frontier coloring by the colors of the added node. Implements range_fn.
+ *
+ * @param arg       The pass_t.
+ * @param from      The first input entry.
+ * @param to        The entry after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void addRange(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Sum the entries which differ only in the digit of a dropped node. Implements range_fn.
+ *
+ * @param arg       The pass_t.
+ * @param from      The first output entry.
+ * @param to        The entry after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void dropRange(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Count the colorings of a component by backtracking on all cores.
+ *
+ * @details Nodes 0 and 1 are adjacent in breadth-first order, so they are fixed to colors 0 and 1 and the count
+ * is multiplied by 6.
+ *
+ * @param c     The component.
+ * @param total The total count the result is multiplied into.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int backtrackCount(const component_t *c, bignum_t *total);
+
+/**
+ * @brief Count the colorings of a range of work items. Implements range_fn.
+ *
+ * @param arg       The backtrack_t.
+ * @param from      The first work item.
+ * @param to        The work item after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void backtrackRange(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Count the colorings which extend the prefix colors of a work item.
+ *
+ * @details The colors of the last node are counted instead of tried.
+ *
+ * @param bt    The shared state.
+ * @param item  The work item, whose base 3 digits are the colors of nodes 2 to prefixN+1.
+ * @param color The buffer for the colors of the nodes.
+ * @param avail The buffer for the untried colors of each node as bitmasks.
+ * @return Returns the number of colorings.
+ */
+static uint64_t countItem(const backtrack_t *bt, int item, char *color, unsigned char *avail);
+
+/**
+ * @brief Compute the colors a node can take next to its lower numbered neighbors.
+ *
+ * @param c     The component.
+ * @param color The colors of the lower numbered nodes.
+ * @param v     The node.
+ * @return Returns the free colors as bitmask.
+ */
+static int freeColors(const component_t *c, const char *color, int v);
+
+/**
+ * @brief Multiply a count by a factor.
+ *
+ * @param b         The count.
+ * @param factor    The limbs of the factor, least significant first.
+ * @param len       The number of limbs of the factor.
+ * @return Returns 0 on success and -1 if memory could not be allocated, in which case the count is unchanged.
+ */
+static int multiplyBig(bignum_t *b, const uint32_t *factor, int len);
+
+/**
+ * @brief Multiply a count by a power of 2.
+ *
+ * @param b     The count.
+ * @param bits  The exponent.
+ * @return Returns 0 on success and -1 if memory could not be allocated, in which case the count is unchanged.
+ */
+static int shiftBig(bignum_t *b, int bits);
+
+/**
+ * @brief Check whether a count is zero.
+ *
+ * @param b The count.
+ * @return Returns non-zero if the count is zero.
+ */
+static int isZero(const bignum_t *b);
+
+/**
+ * @brief Convert a count to decimal.
+ *
+ * @param b The count.
+ * @return Returns the allocated decimal string or NULL if memory could not be allocated.
+ */
+static char *decimalBig(const bignum_t *b);
+
+
+int countColorings(const graph_t *g, char **decimal) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    const int HALF = g->offset[g->nodeN];
+    bignum_t total = {malloc(sizeof(uint32_t)), 1};
+    int *degree = malloc(N * sizeof(int)), *label = malloc(N * sizeof(int)), *order = malloc(N * sizeof(int));
+    component_t comp = {0, malloc((N + 1) * sizeof(int)), malloc((HALF > 0 ? HALF : 1) * sizeof(int)),
+        malloc(N * sizeof(int))};
+    int status = 0;
+    if (total.limb == NULL || degree == NULL || label == NULL || order == NULL || comp.offset == NULL
+            || comp.adj == NULL || comp.last == NULL)
+        status = -1;
+    else
+        total.limb[0] = g->loopN > 0 ? 0 : 1;
+
+    int twos = 0, threes = 0, queueN = 0;
+    for (int v = 0; v < g->nodeN && status == 0; v++) {
+        degree[v] = g->offset[v+1] - g->offset[v];
+        label[v] = -1;
+        if (degree[v] <= 1)
+            order[queueN++] = v;
+    }
+    for (int q = 0; q < queueN; q++) {
+        const int V = order[q];
+        if (degree[V] == 0)
+            threes++;
+        else
+            twos++;
+        label[V] = PEELED;
+        cursor_t cur;
+        initCursor(&cur, g, V);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            if (label[u] != PEELED && --degree[u] == 1)
+                order[queueN++] = u;
+        }
+    }
+
+    for (int s = 0; s < g->nodeN && status == 0 && !isZero(&total); s++) {
+        if (label[s] != -1)
+            continue;
+        const int SIZE = breadthFirst(g, s, label, -1, 0, order);
+        breadthFirst(g, order[SIZE-1], label, MARKED, 1, order);
+        comp.nodeN = SIZE;
+        comp.offset[0] = 0;
+        for (int i = 0, k = 0; i < SIZE; i++) {
+            cursor_t cur;
+            initCursor(&cur, g, order[i]);
+            for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+                if (label[u] >= 0)
+                    comp.adj[k++] = label[u];
+            }
+            comp.offset[i+1] = k;
+        }
+        status = countComponent(&comp, &total);
+    }
+
+    if (status == 0 && !isZero(&total)) {
+        status = shiftBig(&total, twos);
+        for (; status == 0 && threes > 0; threes -= POW3_LIMB) {
+            uint32_t factor = 1;
+            for (int k = 0; k < threes && k < POW3_LIMB; k++)
+                factor *= COLORS;
+            status = multiplyBig(&total, &factor, 1);
+        }
+    }
+    if (status == 0 && (*decimal = decimalBig(&total)) == NULL)
+        status = -1;
+
+    free(total.limb);
+    free(degree);
+    free(label);
+    free(order);
+    free(comp.offset);
+    free(comp.adj);
+    free(comp.last);
+    return status;
+}
+
+
+static int breadthFirst(const graph_t *g, int root, int *label, int seen, int number, int *order) {
+    int n = 1;
+    order[0] = root;
+    label[root] = number ? 0 : MARKED;
+    for (int q = 0; q < n; q++) {
+        cursor_t cur;
+        initCursor(&cur, g, order[q]);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            if (label[u] != seen)
+                continue;
+            label[u] = number ? n : MARKED;
+            order[n++] = u;
+        }
+    }
+    return n;
+}
+
+static int countComponent(component_t *c, bignum_t *total) {
+    size_t cells;
+    const int WIDTH = pathWidth(c, &cells);
+    if (WIDTH < 0)
+        return -1;
+    if (WIDTH <= PATH_WIDTH)
+        return pathCount(c, cells, total);
+    return backtrackCount(c, total);
+}
+
+static int pathWidth(component_t *c, size_t *cells) {
+    const int N = c->nodeN;
+    int *ends = calloc(N, sizeof(int));
+    if (ends == NULL)
+        return -1;
+    for (int v = 0; v < N; v++) {
+        c->last[v] = v;
+        for (int h = c->offset[v]; h < c->offset[v+1]; h++) {
+            if (c->adj[h] > c->last[v])
+                c->last[v] = c->adj[h];
+        }
+        ends[c->last[v]]++;
+    }
+
+    int width = 0, active = 0;
+    *cells = 1;
+    for (int i = 0; i < N && width <= PATH_WIDTH; i++) {
+        active++;
+        if (active > width)
+            width = active;
+        size_t size = LIMBS(i);
+        for (int k = 0; k < active && k <= PATH_WIDTH; k++)
+            size *= COLORS;
+        if (size > *cells)
+            *cells = size;
+        active -= ends[i];
+    }
+    free(ends);
+    return width;
+}
+
+static int pathCount(const component_t *c, size_t cells, bignum_t *total) {
+    uint32_t *table[2] = {malloc(cells * sizeof(uint32_t)), malloc(cells * sizeof(uint32_t))};
+    if (table[0] == NULL || table[1] == NULL) {
+        free(table[0]);
+        free(table[1]);
+        return -1;
+    }
+
+    int pow3[PATH_WIDTH + 1], slot[PATH_WIDTH], w = 0, size = 1, limbs = 1;
+    pow3[0] = 1;
+    for (int k = 1; k <= PATH_WIDTH; k++)
+        pow3[k] = pow3[k-1] * COLORS;
+    table[0][0] = 1;
+    for (int i = 0; i < c->nodeN; i++) {
+        pass_t p = {table[0], table[1], limbs, LIMBS(i), size, 0, {0}};
+        for (int h = c->offset[i]; h < c->offset[i+1]; h++) {
+            for (int j = 0; j < w; j++) {
+                if (slot[j] == c->adj[h])
+                    p.nbrPower[p.nbrN++] = pow3[j];
+            }
+        }
+        parallelFor(size, ENTRIES_PER_THREAD, addRange, &p);
+        uint32_t *swap = table[0];
+        table[0] = table[1];
+        table[1] = swap;
+        slot[w++] = i;
+        size *= COLORS;
+        limbs = LIMBS(i);
+
+        for (int j = w - 1; j >= 0; j--) {
+            if (c->last[slot[j]] != i)
+                continue;
+            size /= COLORS;
+            pass_t q = {table[0], table[1], limbs, limbs, pow3[j], 0, {0}};
+            parallelFor(size, ENTRIES_PER_THREAD, dropRange, &q);
+            swap = table[0];
+            table[0] = table[1];
+            table[1] = swap;
+            memmove(&slot[j], &slot[j+1], (w - j - 1) * sizeof(int));
+            w--;
+        }
+    }
+
+    const int STATUS = multiplyBig(total, table[0], limbs);
+    free(table[0]);
+    free(table[1]);
+    return STATUS;
+}
+
+static void addRange(void *arg, int from, int to, int thread) {
+    const pass_t *p = arg;
+    for (int idx = from; idx < to; idx++) {
+        int used = 0;
+        for (int k = 0; k < p->nbrN; k++)
+            used |= 1 << (idx / p->nbrPower[k] % COLORS);
+        const uint32_t *src = &p->src[(size_t) idx * p->srcLimbs];
+        for (int c = 0; c < COLORS; c++) {
+            uint32_t *dst = &p->dst[((size_t) c * p->power + idx) * p->dstLimbs];
+            memset(dst, 0, p->dstLimbs * sizeof(uint32_t));
+            if ((used >> c & 1) == 0)
+                memcpy(dst, src, p->srcLimbs * sizeof(uint32_t));
+        }
+    }
+}
+
+static void dropRange(void *arg, int from, int to, int thread) {
+    const pass_t *p = arg;
+    const int L = p->dstLimbs;
+    for (int idx = from; idx < to; idx++) {
+        const size_t BASE = (size_t) (idx / p->power) * p->power * COLORS + idx % p->power;
+        uint32_t *dst = &p->dst[(size_t) idx * L];
+        uint64_t carry = 0;
+        for (int k = 0; k < L; k++) {
+            uint64_t sum = carry;
+            for (int c = 0; c < COLORS; c++)
+                sum += p->src[(BASE + (size_t) c * p->power) * L + k];
+            dst[k] = (uint32_t) sum;
+            carry = sum >> 32;
+        }
+    }
+}
+
+static int backtrackCount(const component_t *c, bignum_t *total) {
+    backtrack_t bt;
+    memset(&bt, 0, sizeof(bt));
+    bt.comp = c;
+    bt.prefixN = c->nodeN - 2 < PREFIX_NODES ? c->nodeN - 2 : PREFIX_NODES;
+    int items = 1;
+    for (int k = 0; k < bt.prefixN; k++)
+        items *= COLORS;
+    parallelFor(items, 1, backtrackRange, &bt);
+    if (bt.failed)
+        return -1;
+
+    uint64_t count = 0;
+    for (int t = 0; t < MAX_THREADS; t++)
+        count += bt.count[t];
+    const uint32_t LIMB[2] = {(uint32_t) count, (uint32_t) (count >> 32)}, SYMMETRY = 6;
+    if (multiplyBig(total, LIMB, 2) < 0)
+        return -1;
+    return multiplyBig(total, &SYMMETRY, 1);
+}
+
+static void backtrackRange(void *arg, int from, int to, int thread) {
+    backtrack_t *bt = arg;
+    char *color = malloc(bt->comp->nodeN);
+    unsigned char *avail = malloc(bt->comp->nodeN);
+    if (color == NULL || avail == NULL)
+        __atomic_store_n(&bt->failed, 1, __ATOMIC_RELAXED);
+    for (int item = from; item < to && color != NULL && avail != NULL; item++)
+        bt->count[thread] += countItem(bt, item, color, avail);
+    free(color);
+    free(avail);
+}
+
+static uint64_t countItem(const backtrack_t *bt, int item, char *color, unsigned char *avail) {
+    const component_t *c = bt->comp;
+    const int N = c->nodeN, FIRST = 2 + bt->prefixN;
+    color[0] = 0;
+    color[1] = 1;
+    for (int v = 2; v < FIRST; v++, item /= COLORS) {
+        color[v] = item % COLORS;
+        if ((freeColors(c, color, v) >> color[v] & 1) == 0)
+            return 0;
+    }
+    if (FIRST == N)
+        return 1;
+
+    uint64_t count = 0;
+    int v = FIRST;
+    avail[v] = freeColors(c, color, v);
+    while (v >= FIRST) {
+        if (v == N - 1) {
+            count += __builtin_popcount(avail[v]);
+            v--;
+        } else if (avail[v] == 0)
+            v--;
+        else {
+            color[v] = __builtin_ctz(avail[v]);
+            avail[v] &= avail[v] - 1;
+            v++;
+            avail[v] = freeColors(c, color, v);
+        }
+    }
+    return count;
+}
+
+static int freeColors(const component_t *c, const char *color, int v) {
+    int mask = (1 << COLORS) - 1;
+    for (int h = c->offset[v]; h < c->offset[v+1]; h++) {
+        if (c->adj[h] < v)
+            mask &= ~(1 << color[c->adj[h]]);
+    }
+    return mask;
+}
+
+static int multiplyBig(bignum_t *b, const uint32_t *factor, int len) {
+    while (len > 1 && factor[len-1] == 0)
+        len--;
+    uint32_t *prod = calloc(b->len + len, sizeof(uint32_t));
+    if (prod == NULL)
+        return -1;
+    for (int j = 0; j < len; j++) {
+        uint64_t carry = 0;
+        for (int i = 0; i < b->len; i++) {
+            const uint64_t T = (uint64_t) b->limb[i] * factor[j] + prod[i+j] + carry;
+            prod[i+j] = (uint32_t) T;
+            carry = T >> 32;
+        }
+        prod[b->len + j] = (uint32_t) carry;
+    }
+    free(b->limb);
+    b->limb = prod;
+    b->len += len;
+    while (b->len > 1 && b->limb[b->len-1] == 0)
+        b->len--;
+    return 0;
+}
+
+static int shiftBig(bignum_t *b, int bits) {
+    const int WORDS = bits / 32, BITS = bits % 32;
+    uint32_t *res = calloc(b->len + WORDS + 1, sizeof(uint32_t));
+    if (res == NULL)
+        return -1;
+    for (int i = 0; i < b->len; i++) {
+        const uint64_t T = (uint64_t) b->limb[i] << BITS;
+        res[i+WORDS] |= (uint32_t) T;
+        res[i+WORDS+1] = (uint32_t) (T >> 32);
+    }
+    free(b->limb);
+    b->limb = res;
+    b->len += WORDS + 1;
+    while (b->len > 1 && b->limb[b->len-1] == 0)
+        b->len--;
+    return 0;
+}
+
+static int isZero(const bignum_t *b) {
+    return b->len == 1 && b->limb[0] == 0;
+}
+
+static char *decimalBig(const bignum_t *b) {
+    const int DIGITS = b->len * 10 + 9;
+    char *str = malloc(DIGITS + 1);
+    uint32_t *rest = malloc(b->len * sizeof(uint32_t));
+    if (str == NULL || rest == NULL) {
+        free(str);
+        free(rest);
+        return NULL;
+    }
+    memcpy(rest, b->limb, b->len * sizeof(uint32_t));
+
+    int len = b->len, pos = DIGITS;
+    str[pos] = '\0';
+    do {
+        uint64_t rem = 0;
+        for (int i = len - 1; i >= 0; i--) {
+            const uint64_t CUR = rem << 32 | rest[i];
+            rest[i] = CUR / 1000000000;
+            rem = CUR % 1000000000;
+        }
+        while (len > 0 && rest[len-1] == 0)
+            len--;
+        for (int k = 0; k < 9; k++) {
+            str[--pos] = '0' + rem % 10;
+            rem /= 10;
+            if (len == 0 && rem == 0)
+                break;
+        }
+    } while (len > 0);
+
+    memmove(str, &str[pos], DIGITS + 1 - pos);
+    free(rest);
+    return str;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file count.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Counting the proper 3-colorings of a graph.
+ *
+ * @details Nodes with at most one remaining neighbor are peeled off first. A node without neighbors multiplies the
+ * count by 3, a node with a single neighbor by 2 whatever color the neighbor has. The remaining 2-core is split into
+ * connected components whose counts multiply. Every component is numbered in breadth-first order from a
+ * pseudo-peripheral node, which gives a path decomposition: after the first i nodes only the colors of the frontier,
+ * the counted nodes with neighbors still to come, matter. If the frontier never exceeds PATH_WIDTH nodes, a dynamic
+ * program counts the colorings per frontier coloring, indexed as base 3 numbers, and adds the nodes one by one.
+ * Otherwise a backtracking counter walks all colorings, with the colors of the first nodes fixed per work item and
+ * the items split across threads.
+ * Counts are exact at any size. Every prefix of a breadth-first order is connected, so the count after i nodes is
+ * at most 3 * 2^(i-1), which gives the number of 32 bit limbs each table entry needs at that point.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define PATH_WIDTH      13  /**< The maximum frontier of the dynamic program, whose tables have 3^PATH_WIDTH entries. */
+#define PREFIX_NODES    6   /**< The number of nodes whose colors are fixed by each work item of the backtracking. */
+
+/**
+ * @brief Count the proper colorings of a graph.
+ *
+ * @details The graph must not have parallel edges. A graph with self-loops has no proper coloring.
+ *
+ * @param g         The graph.
+ * @param decimal   The address where the count should be stored as an allocated decimal string.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int countColorings(const graph_t *g, char **decimal);
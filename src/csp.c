@@ -0,0 +1,626 @@
+/**
+ * @file csp.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief An exact decision whether a graph is 3-colorable, by branching on a (3,2)-constraint satisfaction problem.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "parallel.h"
+#include "csp.h"
+
+#define LITERALS    (COLORS * CSP_NODES)    /**< The number of values, one per variable and color. */
+#define WORDS       ((LITERALS + 63) / 64)  /**< The number of 64 bit words of a bitset over the values. */
+#define POLL_NODES  (1 << 12)               /**< The number of search nodes between two polls of the callback. */
+#define ELIMINATED  -2                      /**< The color of a variable which was eliminated. */
+#define TRIPLETS    UINT64_C(0x9249249249249249)    /**< The bits 0, 3, ..., 63, where variables start in word 0. */
+
+#define HAS_BIT(set, i)     ((set)[(i) >> 6] >> ((i) & 63) & 1)
+#define SET_BIT(set, i)     ((set)[(i) >> 6] |= UINT64_C(1) << ((i) & 63))
+#define CLEAR_BIT(set, i)   ((set)[(i) >> 6] &= ~(UINT64_C(1) << ((i) & 63)))
+
+typedef struct csp {                        /**< A (3,2)-constraint satisfaction problem. */
+    int nodeN;                              /**< The number of variables. */
+    int elimN;                              /**< The number of variables eliminated since the last branching. */
+    uint64_t alive[WORDS];                  /**< The allowed values, bit COLORS*v+c for color c of variable v. */
+    signed char color[CSP_NODES];           /**< The fixed color of every variable, -1 or ELIMINATED. */
+    unsigned char elim[CSP_NODES];          /**< The variables eliminated since the last branching, in order. */
+    unsigned char pair[CSP_NODES];          /**< The bitmask of the two values each of these variables had left. */
+    uint64_t conflict[LITERALS][WORDS];     /**< The values excluded by each value. Never changed once it is removed. */
+} csp_t;
+
+typedef struct branch {                     /**< The children of a branching. The last one continues in place. */
+    int childN;                             /**< The number of children, 2 or COLORS. */
+    int drop[COLORS];                       /**< The value each child removes or -1. */
+    int fix[COLORS];                        /**< The value each child fixes afterwards or -1. */
+} branch_t;
+
+typedef struct decision {                   /**< The state shared by the threads of the search. */
+    const csp_t *root;                      /**< The reduced problem before the first branching. */
+    report_fn report;                       /**< The callback polled for termination. */
+    int found;                              /**< Set when a coloring was found. Accessed atomically. */
+    int quit;                               /**< Set when the callback ended the search. Accessed atomically. */
+    csp_t *levels;                          /**< The problems of every level of recursion, levelN per thread. */
+    int levelN;                             /**< The number of levels of a thread, one more than the variables. */
+    long steps[MAX_THREADS];                /**< The number of search nodes of each thread. */
+    signed char colors[CSP_NODES];          /**< The colors of the variables in the coloring that was found. */
+} decision_t;
+
+/**
+ * @brief Search the branches of a range of work items. Implements range_fn.
+ *
+ * @param arg       The decision_t.
+ * @param from      The first work item.
+ * @param to        The work item after the last one.
+ * @param thread    The index of the thread.
+ */
+static void searchItems(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Reduce a problem and branch on it until a solution is found or all branches failed.
+ *
+ * @details The problem is changed in place. Every child but the last is searched in a copy in the problem after it,
+ * which belongs to the next level of recursion, the last one continues in the problem itself. Each of these choices
+ * is one branching: while depth is below BRANCH_DEPTH, bit depth of the path decides whether the child is searched or
+ * skipped, and a solution found before that is only reported by the path whose remaining bits are zero.
+ *
+ * @param d         The shared state.
+ * @param s         The problem of the level of recursion within the levels of the thread.
+ * @param depth     The number of branchings above the problem.
+ * @param path      The work item whose bits decide the first branchings.
+ * @param thread    The index of the thread.
+ * @param out       The buffer where the colors of the variables should be stored, initialized to -1.
+ * @return Returns 1 if a solution was found, 0 if there is none in this branch and -1 if the search was stopped.
+ */
+static int searchBranch(decision_t *d, csp_t *s, int depth, int path, int thread, signed char *out);
+
+/**
+ * @brief Copy a problem, leaving out the rows of values beyond its variables.
+ *
+ * @param dst   The copy.
+ * @param src   The problem.
+ */
+static void copyProblem(csp_t *dst, const csp_t *src);
+
+/**
+ * @brief Apply the reduction rules until none of them applies.
+ *
+ * @details Afterwards every open variable has all COLORS values, every value has a constraint, and no value excludes
+ * all values of another variable or all values excluded by another value of its own variable.
+ *
+ * @param s The problem.
+ * @return Returns 0 if variables are left open, -1 if no variable is open and -2 if a variable has no values left.
+ */
+static int reduceProblem(csp_t *s);
+
+/**
+ * @brief Pick the branching with the smallest work factor of the case analysis.
+ *
+ * @param s The reduced problem.
+ * @param b The branching which should be filled in.
+ */
+static void chooseBranch(const csp_t *s, branch_t *b);
+
+/**
+ * @brief Apply one child of a branching to a problem.
+ *
+ * @param s The problem.
+ * @param b The branching.
+ * @param i The index of the child.
+ */
+static void applyChild(csp_t *s, const branch_t *b, int i);
+
+/**
+ * @brief Fix a variable to a value and remove every value which is excluded by it.
+ *
+ * @param s     The problem.
+ * @param lit   The value, COLORS*v+c for color c of variable v.
+ */
+static void fixValue(csp_t *s, int lit);
+
+/**
+ * @brief Eliminate a variable with two values by pairing their constraints.
+ *
+ * @details Every value excluded by the first value gets a constraint with every value excluded by the second, unless
+ * both belong to the same variable. A value which excludes both is removed right away.
+ *
+ * @param s     The problem.
+ * @param v     The variable.
+ * @param dom   The bitmask of its two values.
+ */
+static void eliminateVariable(csp_t *s, int v, int dom);
+
+/**
+ * @brief Give the variables eliminated in a problem a value, latest first, which fits the colors of all others.
+ *
+ * @param s     The problem.
+ * @param out   The colors of the variables, where the eliminated ones are filled in.
+ */
+static void restoreEliminated(const csp_t *s, signed char *out);
+
+/**
+ * @brief Get the allowed values of a variable.
+ *
+ * @param s The problem.
+ * @param v The variable.
+ * @return Returns the bitmask of the allowed colors.
+ */
+static int domainOf(const csp_t *s, int v);
+
+/**
+ * @brief Count the allowed values which are excluded by a value.
+ *
+ * @param s     The problem.
+ * @param lit   The value.
+ * @return Returns the number of constraints of the value.
+ */
+static int countConstraints(const csp_t *s, int lit);
+
+/**
+ * @brief Count the variables whose allowed values are excluded by a value.
+ *
+ * @param s     The problem.
+ * @param lit   The value.
+ * @return Returns the number of variables.
+ */
+static int spanOf(const csp_t *s, int lit);
+
+/**
+ * @brief Check whether a value excludes all three values of another variable.
+ *
+ * @details The three bits of a variable are found by and-ing the excluded values with themselves shifted by one and
+ * two bits, carrying in the bits of the next word. Since 64 leaves a remainder of one, the variables of word w start
+ * at the bits of TRIPLETS shifted by 2w mod 3.
+ *
+ * @param s     The problem.
+ * @param lit   The value.
+ * @return Returns 1 if it does and 0 otherwise.
+ */
+static int excludesVariable(const csp_t *s, int lit);
+
+/**
+ * @brief Get the lowest allowed value which is excluded by a value.
+ *
+ * @param s     The problem.
+ * @param lit   The value, which must have a constraint.
+ * @return Returns the excluded value.
+ */
+static int firstConstraint(const csp_t *s, int lit);
+
+
+int decideColoring(const graph_t *g, report_fn report, char *colors) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    int *degree = malloc(N * sizeof(int)), *order = malloc(N * sizeof(int)), *label = malloc(N * sizeof(int));
+    csp_t *root = malloc(sizeof(csp_t));
+    if (degree == NULL || order == NULL || label == NULL || root == NULL) {
+        free(degree);
+        free(order);
+        free(label);
+        free(root);
+        return -3;
+    }
+
+    // Peel nodes with less than three remaining neighbors, label -2 marks them
+    int peeled = 0, coreN = 0;
+    for (int v = 0; v < g->nodeN; v++) {
+        degree[v] = g->offset[v+1] - g->offset[v];
+        label[v] = -1;
+        if (degree[v] < COLORS) {
+            label[v] = -2;
+            order[peeled++] = v;
+        }
+    }
+    for (int i = 0; i < peeled; i++) {
+        cursor_t cur;
+        initCursor(&cur, g, order[i]);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            if (label[u] == -1 && --degree[u] < COLORS) {
+                label[u] = -2;
+                order[peeled++] = u;
+            }
+        }
+    }
+    for (int v = 0; v < g->nodeN; v++) {
+        if (label[v] == -1)
+            label[v] = coreN++;
+    }
+    if (coreN > CSP_NODES) {
+        free(degree);
+        free(order);
+        free(label);
+        free(root);
+        return -2;
+    }
+
+    memset(root, 0, sizeof(csp_t));
+    root->nodeN = coreN;
+    int first = -1;
+    for (int v = 0; v < g->nodeN; v++) {
+        if (label[v] < 0)
+            continue;
+        const int I = label[v];
+        root->color[I] = -1;
+        for (int c = 0; c < COLORS; c++)
+            SET_BIT(root->alive, COLORS * I + c);
+        cursor_t cur;
+        initCursor(&cur, g, v);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            for (int c = 0; c < COLORS && label[u] >= 0; c++)
+                SET_BIT(root->conflict[COLORS * I + c], COLORS * label[u] + c);
+        }
+        if (first < 0 || degree[v] > degree[first])
+            first = v;
+    }
+    // Swapping colors keeps a coloring proper, so the node of most degree and one of its neighbors are fixed
+    if (first >= 0) {
+        fixValue(root, COLORS * label[first]);
+        cursor_t cur;
+        initCursor(&cur, g, first);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            if (label[u] >= 0) {
+                fixValue(root, COLORS * label[u] + 1);
+                break;
+            }
+        }
+    }
+
+    // Every child but the last fixes a variable, so no thread recurses deeper than one level per variable
+    decision_t d;
+    memset(&d, 0, sizeof(d));
+    d.root = root;
+    d.report = report;
+    d.levelN = coreN + 1;
+    d.levels = malloc((size_t) parallelThreads(1 << BRANCH_DEPTH, 1) * d.levelN * sizeof(csp_t));
+    if (d.levels == NULL) {
+        free(degree);
+        free(order);
+        free(label);
+        free(root);
+        return -3;
+    }
+    parallelFor(1 << BRANCH_DEPTH, 1, searchItems, &d);
+    free(d.levels);
+    free(root);
+    if (!d.found) {
+        free(degree);
+        free(order);
+        free(label);
+        return d.quit ? -1 : 0;
+    }
+
+    // Color the peeled nodes in reverse order, each has at most two colored neighbors
+    for (int v = 0; v < g->nodeN; v++) {
+        if (label[v] >= 0)
+            colors[v] = d.colors[label[v]];
+    }
+    for (int i = peeled - 1; i >= 0; i--) {
+        const int V = order[i];
+        int used = 0;
+        cursor_t cur;
+        initCursor(&cur, g, V);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            if (label[u] != -2)
+                used |= 1 << colors[u];
+        }
+        int c = 0;
+        while (used >> c & 1)
+            c++;
+        colors[V] = c;
+        label[V] = -3;
+    }
+    free(degree);
+    free(order);
+    free(label);
+    return 1;
+}
+
+
+static void searchItems(void *arg, int from, int to, int thread) {
+    decision_t *d = arg;
+    csp_t *level = d->levels + (size_t) thread * d->levelN;
+    signed char out[CSP_NODES];
+    for (int item = from; item < to; item++) {
+        if (__atomic_load_n(&d->quit, __ATOMIC_RELAXED) || __atomic_load_n(&d->found, __ATOMIC_RELAXED))
+            break;
+        copyProblem(level, d->root);
+        memset(out, -1, sizeof(out));
+        if (searchBranch(d, level, 0, item, thread, out) != 1)
+            continue;
+        if (__atomic_exchange_n(&d->found, 1, __ATOMIC_ACQ_REL) == 0)
+            memcpy(d->colors, out, sizeof(out));
+    }
+}
+
+static int searchBranch(decision_t *d, csp_t *s, int depth, int path, int thread, signed char *out) {
+    for (;;) {
+        if (++d->steps[thread] % POLL_NODES == 0 && d->report(NULL) != 0)
+            __atomic_store_n(&d->quit, 1, __ATOMIC_RELAXED);
+        if (__atomic_load_n(&d->quit, __ATOMIC_RELAXED) || __atomic_load_n(&d->found, __ATOMIC_RELAXED))
+            return -1;
+
+        const int STATUS = reduceProblem(s);
+        if (STATUS == -2)
+            return 0;
+        if (STATUS == -1) {
+            if (depth < BRANCH_DEPTH && path >> depth != 0)
+                return 0;
+            for (int v = 0; v < s->nodeN; v++)
+                out[v] = s->color[v] >= 0 ? s->color[v] : -1;
+            break;
+        }
+
+        branch_t b;
+        chooseBranch(s, &b);
+        int found = 0;
+        for (int i = 0; i < b.childN - 1 && found == 0; i++, depth++) {
+            if (depth < BRANCH_DEPTH && (path >> depth & 1) != 0)
+                continue;
+            csp_t *child = s + 1;
+            copyProblem(child, s);
+            child->elimN = 0;
+            applyChild(child, &b, i);
+            found = searchBranch(d, child, depth + 1, path, thread, out);
+            if (found < 0 || (found == 0 && depth < BRANCH_DEPTH))
+                return found;
+        }
+        if (found == 1)
+            break;
+        applyChild(s, &b, b.childN - 1);
+    }
+    restoreEliminated(s, out);
+    return 1;
+}
+
+static void copyProblem(csp_t *dst, const csp_t *src) {
+    memcpy(dst, src, offsetof(csp_t, conflict));
+    memcpy(dst->conflict, src->conflict, (size_t) COLORS * src->nodeN * sizeof(src->conflict[0]));
+}
+
+static int reduceProblem(csp_t *s) {
+    for (;;) {
+        int changed = 0, open = 0;
+        for (int v = 0; v < s->nodeN; v++) {
+            if (s->color[v] != -1)
+                continue;
+            const int DOM = domainOf(s, v);
+            if (DOM == 0)
+                return -2;
+            int fix = -1;
+            for (int c = 0; c < COLORS; c++) {
+                uint64_t any = 0;
+                for (int w = 0; w < WORDS && DOM >> c & 1; w++)
+                    any |= s->conflict[COLORS * v + c][w] & s->alive[w];
+                if (DOM >> c & 1 && (DOM == 1 << c || any == 0))
+                    fix = c;
+            }
+            if (fix >= 0) {
+                fixValue(s, COLORS * v + fix);
+                changed = 1;
+                continue;
+            }
+            if (__builtin_popcount(DOM) == 2) {
+                eliminateVariable(s, v, DOM);
+                changed = 1;
+                continue;
+            }
+
+            // A value which excludes every value of another variable is in no solution, checked once the rest is done
+            int dead = -1;
+            for (int c = 0; c < COLORS && dead < 0 && !changed; c++) {
+                if (excludesVariable(s, COLORS * v + c))
+                    dead = c;
+            }
+            if (dead >= 0) {
+                CLEAR_BIT(s->alive, COLORS * v + dead);
+                changed = 1;
+                continue;
+            }
+
+            // A value dominates another if every value excluded by it is excluded by the other as well
+            int drop = -1;
+            for (int a = 0; a < COLORS && drop < 0; a++) {
+                for (int b = 0; b < COLORS && drop < 0; b++) {
+                    const uint64_t *A = s->conflict[COLORS * v + a], *B = s->conflict[COLORS * v + b];
+                    uint64_t extra = 0;
+                    for (int w = 0; w < WORDS && a != b; w++)
+                        extra |= A[w] & s->alive[w] & ~B[w];
+                    if (a != b && extra == 0)
+                        drop = b;
+                }
+            }
+            if (drop >= 0) {
+                CLEAR_BIT(s->alive, COLORS * v + drop);
+                changed = 1;
+                continue;
+            }
+            open++;
+        }
+        if (!changed)
+            return open > 0 ? 0 : -1;
+    }
+}
+
+static void chooseBranch(const csp_t *s, branch_t *b) {
+    // Rank the cases by their work factor on the number of open variables, lowest first
+    enum { WIDE, SINGLE_WIDE, TRIPLE, SINGLE, IMPLIED, CASES };
+    long best = -1;
+    int most = -1, widest = -1;
+    for (int v = 0; v < s->nodeN; v++) {
+        if (s->color[v] != -1)
+            continue;
+        int total = 0;
+        for (int c = 0; c < COLORS; c++) {
+            const int LIT = COLORS * v + c, CONS = countConstraints(s, LIT), SPAN = spanOf(s, LIT);
+            int rank = CASES;
+            total += CONS;
+            int partner = -1;
+            if (SPAN >= 4)
+                rank = WIDE;
+            else if (SPAN == 3)
+                rank = TRIPLE;
+            else if (CONS == 1) {
+                partner = firstConstraint(s, LIT);
+                rank = spanOf(s, partner) >= 2 ? SINGLE_WIDE : SINGLE;
+            } else if (SPAN == 1)
+                rank = IMPLIED;
+            if (rank == CASES)
+                continue;
+            const long SCORE = (long) (CASES - rank) * (LITERALS + 1) + CONS;
+            if (SCORE <= best)
+                continue;
+            best = SCORE;
+            b->childN = 2;
+            b->drop[0] = b->drop[1] = b->fix[0] = b->fix[1] = -1;
+            if (rank == WIDE || rank == TRIPLE) {
+                // (1, 1 + span): fixing the value leaves every constrained variable with two values at most
+                b->fix[0] = LIT;
+                b->drop[1] = LIT;
+            } else if (partner >= 0) {
+                // (2, 2) or (2, 3): unless the only excluded value is taken the value can always be taken
+                b->fix[0] = partner;
+                b->drop[1] = partner;
+                b->fix[1] = LIT;
+            } else {
+                // (2, 2): the value excludes two values of one variable and so implies the third one
+                const int U = firstConstraint(s, LIT) / COLORS;
+                int third = 0;
+                while (HAS_BIT(s->conflict[LIT], COLORS * U + third))
+                    third++;
+                b->fix[0] = COLORS * U + third;
+                b->drop[1] = COLORS * U + third;
+            }
+        }
+        if (total > most) {
+            most = total;
+            widest = v;
+        }
+    }
+    if (best >= 0)
+        return;
+    // (3, 3, 3): every value of every variable excludes values of exactly two others
+    b->childN = COLORS;
+    for (int c = 0; c < COLORS; c++) {
+        b->drop[c] = -1;
+        b->fix[c] = COLORS * widest + c;
+    }
+}
+
+static void applyChild(csp_t *s, const branch_t *b, int i) {
+    if (b->drop[i] >= 0)
+        CLEAR_BIT(s->alive, b->drop[i]);
+    if (b->fix[i] >= 0)
+        fixValue(s, b->fix[i]);
+}
+
+static void fixValue(csp_t *s, int lit) {
+    const int V = lit / COLORS;
+    s->color[V] = lit % COLORS;
+    for (int w = 0; w < WORDS; w++)
+        s->alive[w] &= ~s->conflict[lit][w];
+    for (int c = 0; c < COLORS; c++)
+        CLEAR_BIT(s->alive, COLORS * V + c);
+}
+
+static void eliminateVariable(csp_t *s, int v, int dom) {
+    int lit[2], k = 0;
+    for (int c = 0; c < COLORS; c++) {
+        if (dom >> c & 1)
+            lit[k++] = COLORS * v + c;
+    }
+    uint64_t excluded[2][WORDS];
+    for (int w = 0; w < WORDS; w++) {
+        excluded[0][w] = s->conflict[lit[0]][w] & s->alive[w];
+        excluded[1][w] = s->conflict[lit[1]][w] & s->alive[w];
+    }
+    for (int side = 0; side < 2; side++) {
+        const uint64_t *OTHER = excluded[1 - side];
+        for (int w = 0; w < WORDS; w++) {
+            for (uint64_t bits = excluded[side][w]; bits != 0; bits &= bits - 1) {
+                const int X = 64 * w + __builtin_ctzll(bits), U = X / COLORS;
+                for (int i = 0; i < WORDS; i++)
+                    s->conflict[X][i] |= OTHER[i];
+                for (int c = 0; c < COLORS; c++)
+                    CLEAR_BIT(s->conflict[X], COLORS * U + c);
+            }
+        }
+    }
+    for (int w = 0; w < WORDS; w++)
+        s->alive[w] &= ~(excluded[0][w] & excluded[1][w]);
+    for (int c = 0; c < COLORS; c++)
+        CLEAR_BIT(s->alive, COLORS * v + c);
+    s->color[v] = ELIMINATED;
+    s->elim[s->elimN] = v;
+    s->pair[s->elimN++] = dom;
+}
+
+static void restoreEliminated(const csp_t *s, signed char *out) {
+    uint64_t chosen[WORDS];
+    memset(chosen, 0, sizeof(chosen));
+    for (int v = 0; v < s->nodeN; v++) {
+        if (out[v] >= 0)
+            SET_BIT(chosen, COLORS * v + out[v]);
+    }
+    for (int i = s->elimN - 1; i >= 0; i--) {
+        const int V = s->elim[i];
+        for (int c = 0; c < COLORS; c++) {
+            if ((s->pair[i] >> c & 1) == 0)
+                continue;
+            uint64_t clash = 0;
+            for (int w = 0; w < WORDS; w++)
+                clash |= s->conflict[COLORS * V + c][w] & chosen[w];
+            if (clash == 0 || out[V] < 0)
+                out[V] = c;
+            if (clash == 0)
+                break;
+        }
+        SET_BIT(chosen, COLORS * V + out[V]);
+    }
+}
+
+static int domainOf(const csp_t *s, int v) {
+    int dom = 0;
+    for (int c = 0; c < COLORS; c++)
+        dom |= (int) HAS_BIT(s->alive, COLORS * v + c) << c;
+    return dom;
+}
+
+static int countConstraints(const csp_t *s, int lit) {
+    int count = 0;
+    for (int w = 0; w < WORDS; w++)
+        count += __builtin_popcountll(s->conflict[lit][w] & s->alive[w]);
+    return count;
+}
+
+static int spanOf(const csp_t *s, int lit) {
+    int span = 0, var = -1;
+    for (int w = 0; w < WORDS; w++) {
+        for (uint64_t bits = s->conflict[lit][w] & s->alive[w]; bits != 0; bits &= bits - 1) {
+            const int U = (64 * w + __builtin_ctzll(bits)) / COLORS;
+            span += U != var;
+            var = U;
+        }
+    }
+    return span;
+}
+
+static int excludesVariable(const csp_t *s, int lit) {
+    uint64_t found = 0;
+    for (int w = 0; w < WORDS; w++) {
+        const uint64_t LO = s->conflict[lit][w] & s->alive[w];
+        const uint64_t HI = w + 1 < WORDS ? s->conflict[lit][w+1] & s->alive[w+1] : 0;
+        found |= LO & (LO >> 1 | HI << 63) & (LO >> 2 | HI << 62) & TRIPLETS << (2 * w % 3);
+    }
+    return found != 0;
+}
+
+
+static int firstConstraint(const csp_t *s, int lit) {
+    int w = 0;
+    while ((s->conflict[lit][w] & s->alive[w]) == 0)
+        w++;
+    return 64 * w + __builtin_ctzll(s->conflict[lit][w] & s->alive[w]);
+}
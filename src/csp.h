@@ -0,0 +1,53 @@
+/**
+ * @file csp.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief An exact decision whether a graph is 3-colorable, by branching on a (3,2)-constraint satisfaction problem.
+ *
+ * @details Nodes with less than three remaining neighbors are peeled off first, since they can always be colored
+ * last. Every node of the remaining core becomes a variable with the values 0 to 2, and every edge forbids the pairs
+ * of equal values at its ends. The problem follows Beigel and Eppstein: values and constraints are bitsets over
+ * (node, color) pairs. Every level of the recursion keeps its own copy of the problem, of which only the rows of the
+ * core are copied. Since every branching into a copy fixes a variable, a thread needs one level per core variable and
+ * one more, and the levels of all threads are allocated in one block before the threads start. The search itself is
+ * allocation-free and can't run out of memory inside a branch. Before every branching the problem is reduced until
+ * none of these rules applies:
+ * - A variable without values fails the branch, a variable with a single value is fixed.
+ * - A value without constraints is fixed, since no other value can be harmed by it.
+ * - A value which excludes every value of another variable is dropped.
+ * - A value whose constraints are a subset of another value of the same variable replaces that value.
+ * - A variable with two values is eliminated: every value excluded by the first is paired with every value excluded
+ *   by the second in a new constraint, and the variable later takes whichever value fits the rest.
+ * Afterwards every variable has three values, and the branching follows their case analysis, measured in open
+ * variables:
+ * - A value constraining three or more variables is fixed, which eliminates all of them, or dropped. (4, 1) or (5, 1).
+ * - A value with a single constraint is taken unless the excluded value is: either that value is fixed, or it is
+ *   dropped and the first one fixed. (2, 2), or (2, 3) if the excluded value constrains two variables.
+ * - A value excluding two values of one variable implies the third, which is fixed or dropped. (2, 2).
+ * - Otherwise every value constrains exactly two variables, and a variable is fixed to each of its values. (3, 3, 3).
+ * This bounds the search by O(1.4423^n) for n core nodes. Beigel and Eppstein reach O(1.3645^n) with further cases
+ * which merge variables into ones with four values, which are left out here. The first BRANCH_DEPTH choices between
+ * the children are decided by the work item, and the 2^BRANCH_DEPTH items are split across threads. A thread which
+ * finds a coloring stops the others.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define CSP_NODES       128 /**< The maximum number of nodes left after peeling, which become the variables. */
+#define BRANCH_DEPTH    6   /**< The number of branchings decided by each work item. */
+
+/**
+ * @brief Decide whether a graph has a proper coloring.
+ *
+ * @details The graph must not have parallel edges and its self-loops must have been removed. The callback is only
+ * polled with NULL, possibly from several threads, and ends the search early if it returns non-zero.
+ *
+ * @param g         The graph.
+ * @param report    The callback which is polled for termination.
+ * @param colors    The buffer where a proper coloring should be stored.
+ * @return Returns 1 if a proper coloring was found, 0 if there is none, -1 if the callback ended the search, -2 if
+ * more than CSP_NODES nodes are left after peeling and -3 if memory could not be allocated.
+ */
+int decideColoring(const graph_t *g, report_fn report, char *colors);
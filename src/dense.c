@@ -0,0 +1,485 @@
+/**
+ * @file dense.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A bit matrix representation for dense graphs, on which colorings are evaluated without the edge list.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "parallel.h"
+#include "construct.h"
+#include "dense.h"
+
+#define ROW_CHUNK   2048    /**< The minimum number of rows which justify another evaluation thread. */
+#define POLL_MOVES  1024    /**< The number of moves between two polls of the callback. */
+#define WALK_ODDS   100     /**< A node takes a random color instead of its best one with probability 1 / WALK_ODDS. */
+
+typedef struct evaluation {             /**< The state shared by the threads of an evaluation. */
+    const dense_t *d;                   /**< The bit matrix. */
+    const char *colors;                 /**< The coloring. */
+    long sum[MAX_THREADS];              /**< The conflicts counted by each thread, every edge twice. */
+} evaluation_t;
+
+typedef struct walk {                   /**< The state of the min-conflicts search on a bit matrix. */
+    dense_t d;                          /**< The bit matrix and the color classes of the current coloring. */
+    int k;                              /**< The number of colors. */
+    char *colors;                       /**< The current coloring. */
+    int *same;                          /**< The number of neighbors of every node which share its color. */
+    uint64_t *bad;                      /**< The bitset of the nodes with at least one conflict. */
+    int badN;                           /**< The number of nodes with at least one conflict. */
+    long *tabu;                         /**< tabu[v*k+c] is the move from which on node v may take color c again. */
+    uint64_t state;                     /**< The state of the random generator. */
+} walk_t;
+
+/**
+ * @brief Count the conflicts of a range of rows. Implements range_fn.
+ *
+ * @param arg       The evaluation_t.
+ * @param from      The first row.
+ * @param to        The row after the last one.
+ * @param thread    The index of the thread.
+ */
+static void countRows(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Draw a uniformly random color from a xorshift generator.
+ *
+ * @param state The non-zero state of the generator.
+ * @param k     The number of colors.
+ * @return Returns the color.
+ */
+static int drawColor(uint64_t *state, int k);
+
+/**
+ * @brief Allocate the state of the min-conflicts search.
+ *
+ * @param s The state which should be initialized.
+ * @param g The graph.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int initWalk(walk_t *s, const graph_t *g);
+
+/**
+ * @brief Free the state of the min-conflicts search.
+ *
+ * @param s The state.
+ */
+static void freeWalk(walk_t *s);
+
+/**
+ * @brief Start a run from a coloring of the selected construction.
+ *
+ * @param s The state.
+ * @param g The graph.
+ * @return Returns the number of conflicting edges of the coloring.
+ */
+static int startWalk(walk_t *s, const graph_t *g);
+
+/**
+ * @brief Draw a uniformly random node with at least one conflict.
+ *
+ * @details The words of the bitset are counted off until the drawn index is reached, which takes O(V / 64).
+ *
+ * @param s The state, which must have a conflicting node.
+ * @return Returns the node.
+ */
+static int drawBadNode(walk_t *s);
+
+/**
+ * @brief Count the neighbors of a node which hold a color.
+ *
+ * @param d The bit matrix.
+ * @param v The node.
+ * @param c The color.
+ * @return Returns the population count of the row of v and the set of c.
+ */
+static int countNeighbors(const dense_t *d, int v, int c);
+
+/**
+ * @brief Move a node to another color and update the conflicts of its neighbors.
+ *
+ * @details Only the neighbors in the old and the new class are visited, which are found by the words of the row and
+ * the two classes, so a move takes O(V / 64) plus the number of conflicts it changes.
+ *
+ * @param s The state.
+ * @param v The node.
+ * @param c The new color.
+ */
+static void recolorNode(walk_t *s, int v, int c);
+
+/**
+ * @brief Run the search compiled for the number of row words and colors of a graph of at most SMALL_NODES nodes.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings together with their conflicts.
+ * @return Returns 0.
+ */
+static int smallSearch(const graph_t *g, scored_fn report);
+
+
+int isDense(int nodeN, int edgeN) {
+    const long N = nodeN;
+    return N > 1 && N <= DENSE_NODES && 100L * 2 * edgeN > DENSE_PERCENT * N * (N - 1);
+}
+
+int initDense(dense_t *d, const graph_t *g) {
+    d->nodeN = g->nodeN;
+    d->words = (g->nodeN + 63) / 64;
+    d->adj = calloc((size_t) g->nodeN * d->words + 1, sizeof(uint64_t));
+    d->class = calloc((size_t) MAX_COLORS * d->words + 1, sizeof(uint64_t));
+    if (d->adj == NULL || d->class == NULL) {
+        free(d->adj);
+        free(d->class);
+        return -1;
+    }
+
+    for (int v = 0; v < g->nodeN; v++) {
+        uint64_t *row = &d->adj[(size_t) v * d->words];
+        cursor_t cur;
+        initCursor(&cur, g, v);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;)
+            row[u >> 6] |= UINT64_C(1) << (u & 63);
+    }
+    return 0;
+}
+
+void freeDense(dense_t *d) {
+    free(d->adj);
+    free(d->class);
+}
+
+int loadDense(dense_t *d, const char *colors) {
+    memset(d->class, 0, (size_t) MAX_COLORS * d->words * sizeof(uint64_t));
+    for (int v = 0; v < d->nodeN; v++)
+        d->class[colors[v] * d->words + (v >> 6)] |= UINT64_C(1) << (v & 63);
+
+    evaluation_t ev;
+    ev.d = d;
+    ev.colors = colors;
+    memset(ev.sum, 0, sizeof(ev.sum));
+    parallelFor(d->nodeN, ROW_CHUNK, countRows, &ev);
+    long total = 0;
+    for (int t = 0; t < MAX_THREADS; t++)
+        total += ev.sum[t];
+    return (int) (total / 2);
+}
+
+int denseSearch(const graph_t *g, scored_fn report) {
+    if (g->nodeN <= SMALL_NODES)
+        return smallSearch(g, report);
+
+    walk_t s;
+    if (initWalk(&s, g) < 0)
+        return -1;
+
+    int quit = 0, best = INT_MAX;
+    while (quit == 0) {
+        int total = startWalk(&s, g), record = total;
+        if (total < best) {
+            best = total;
+            quit = report(s.colors, best);
+        } else
+            quit = report(NULL, 0);
+
+        // Move a random conflicting node to its least conflicting color, a tabu color only counts if it sets a record
+        for (long move = 1, last = 0; quit == 0 && total > 0 && move - last <= STALL_MOVES; move++) {
+            const int V = drawBadNode(&s), OLD = s.colors[V];
+            int color = -1, least = INT_MAX, ties = 0;
+            for (int c = 0; c < s.k; c++) {
+                const int AFTER = total - s.same[V] + countNeighbors(&s.d, V, c);
+                if (c != OLD && s.tabu[(long) V * s.k + c] > move && AFTER >= best)
+                    continue;
+                if (AFTER < least) {
+                    least = AFTER;
+                    color = c;
+                    ties = 1;
+                } else if (AFTER == least && drawColor(&s.state, ++ties) == 0)
+                    color = c;
+            }
+            if (drawColor(&s.state, WALK_ODDS) == 0) {
+                color = drawColor(&s.state, s.k);
+                least = total - s.same[V] + countNeighbors(&s.d, V, color);
+            }
+            if (color != OLD) {
+                s.tabu[(long) V * s.k + OLD] = move + drawColor(&s.state, 10) + (6 * s.badN) / 10;
+                recolorNode(&s, V, color);
+                total = least;
+            }
+            if (total < record) {
+                record = total;
+                last = move;
+            }
+            if (total < best) {
+                best = total;
+                quit = report(s.colors, best);
+            } else if (move % POLL_MOVES == 0)
+                quit = report(NULL, 0);
+        }
+    }
+
+    freeWalk(&s);
+    return 0;
+}
+
+
+static void countRows(void *arg, int from, int to, int thread) {
+    evaluation_t *ev = arg;
+    const int WORDS = ev->d->words;
+    long sum = 0;
+    for (int v = from; v < to; v++) {
+        const uint64_t *ROW = &ev->d->adj[(size_t) v * WORDS], *CLASS = &ev->d->class[ev->colors[v] * WORDS];
+        for (int w = 0; w < WORDS; w++)
+            sum += __builtin_popcountll(ROW[w] & CLASS[w]);
+    }
+    ev->sum[thread] = sum;
+}
+
+static int drawColor(uint64_t *state, int k) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (int) ((*state >> 32) * k >> 32);
+}
+
+static int initWalk(walk_t *s, const graph_t *g) {
+    const size_t N = g->nodeN > 0 ? g->nodeN : 1;
+    s->k = getColorCount();
+    s->colors = malloc(N);
+    s->same = malloc(N * sizeof(int));
+    s->bad = malloc((N + 63) / 64 * sizeof(uint64_t));
+    s->tabu = malloc(N * s->k * sizeof(long));
+    if (s->colors == NULL || s->same == NULL || s->bad == NULL || s->tabu == NULL || initDense(&s->d, g) < 0) {
+        free(s->colors);
+        free(s->same);
+        free(s->bad);
+        free(s->tabu);
+        return -1;
+    }
+    s->state = (uint64_t) random() << 32 | (uint64_t) random() | 1;
+    return 0;
+}
+
+static void freeWalk(walk_t *s) {
+    freeDense(&s->d);
+    free(s->colors);
+    free(s->same);
+    free(s->bad);
+    free(s->tabu);
+}
+
+static int startWalk(walk_t *s, const graph_t *g) {
+    initialColoring(g, s->colors);
+    const int TOTAL = loadDense(&s->d, s->colors);
+    memset(s->bad, 0, s->d.words * sizeof(uint64_t));
+    memset(s->tabu, 0, (size_t) s->d.nodeN * s->k * sizeof(long));
+    s->badN = 0;
+    for (int v = 0; v < s->d.nodeN; v++) {
+        s->same[v] = countNeighbors(&s->d, v, s->colors[v]);
+        if (s->same[v] > 0) {
+            s->bad[v >> 6] |= UINT64_C(1) << (v & 63);
+            s->badN++;
+        }
+    }
+    return TOTAL;
+}
+
+static int drawBadNode(walk_t *s) {
+    int index = drawColor(&s->state, s->badN), w = 0;
+    while (index >= __builtin_popcountll(s->bad[w]))
+        index -= __builtin_popcountll(s->bad[w++]);
+    uint64_t bits = s->bad[w];
+    while (index-- > 0)
+        bits &= bits - 1;
+    return 64 * w + __builtin_ctzll(bits);
+}
+
+static int countNeighbors(const dense_t *d, int v, int c) {
+    const uint64_t *ROW = &d->adj[(size_t) v * d->words], *CLASS = &d->class[c * d->words];
+    int count = 0;
+    for (int w = 0; w < d->words; w++)
+        count += __builtin_popcountll(ROW[w] & CLASS[w]);
+    return count;
+}
+
+static void recolorNode(walk_t *s, int v, int c) {
+    const int WORDS = s->d.words, OLD = s->colors[v];
+    const uint64_t *ROW = &s->d.adj[(size_t) v * WORDS], BIT = UINT64_C(1) << (v & 63);
+    uint64_t *from = &s->d.class[OLD * WORDS], *to = &s->d.class[c * WORDS];
+    for (int w = 0; w < WORDS; w++) {
+        for (uint64_t bits = ROW[w] & from[w]; bits != 0; bits &= bits - 1) {
+            if (--s->same[64 * w + __builtin_ctzll(bits)] == 0) {
+                s->bad[w] &= ~(bits & -bits);
+                s->badN--;
+            }
+        }
+        for (uint64_t bits = ROW[w] & to[w]; bits != 0; bits &= bits - 1) {
+            if (s->same[64 * w + __builtin_ctzll(bits)]++ == 0) {
+                s->bad[w] |= bits & -bits;
+                s->badN++;
+            }
+        }
+    }
+    from[v >> 6] &= ~BIT;
+    to[v >> 6] |= BIT;
+    s->colors[v] = c;
+
+    const int BEFORE = s->same[v];
+    s->same[v] = countNeighbors(&s->d, v, c);
+    if ((BEFORE > 0) != (s->same[v] > 0)) {
+        s->bad[v >> 6] ^= BIT;
+        s->badN += s->same[v] > 0 ? 1 : -1;
+    }
+}
+
+/**
+ * @brief Define the search for graphs of at most 64*W nodes and K colors, whose rows and color classes are arrays of W
+ * words.
+ *
+ * @param W     The number of words of a row.
+ * @param K     The number of colors.
+ */
+#define DEFINE_SMALL_SEARCH(W, K)                                                                                   \
+static int smallSearch##W##_##K(const graph_t *g, scored_fn report) {                                               \
+    const int N = g->nodeN, RANDOM = getConstruction() == CONSTRUCT_RANDOM;                                         \
+    uint64_t adj[64 * (W)][W], class[K][W], bad[W];                                                                 \
+    int same[64 * (W)];                                                                                             \
+    long tabu[64 * (W)][K];                                                                                         \
+    char colors[64 * (W)];                                                                                          \
+    memset(adj, 0, sizeof(adj));                                                                                    \
+    for (int v = 0; v < N; v++) {                                                                                   \
+        cursor_t cur;                                                                                               \
+        initCursor(&cur, g, v);                                                                                     \
+        for (int u; (u = nextNeighbor(&cur)) >= 0;)                                                                 \
+            adj[v][u >> 6] |= UINT64_C(1) << (u & 63);                                                              \
+    }                                                                                                               \
+                                                                                                                    \
+    uint64_t state = (uint64_t) random() << 32 | (uint64_t) random() | 1;                                           \
+    int best = INT_MAX;                                                                                             \
+    for (;;) {                                                                                                      \
+        if (!RANDOM)                                                                                                \
+            initialColoring(g, colors);                                                                             \
+        memset(class, 0, sizeof(class));                                                                            \
+        memset(bad, 0, sizeof(bad));                                                                                \
+        memset(tabu, 0, sizeof(tabu));                                                                              \
+        for (int v = 0; v < N; v++) {                                                                               \
+            if (RANDOM)                                                                                             \
+                colors[v] = drawColor(&state, K);                                                                   \
+            class[(int) colors[v]][v >> 6] |= UINT64_C(1) << (v & 63);                                              \
+        }                                                                                                           \
+        int total = 0, badN = 0;                                                                                    \
+        for (int v = 0; v < N; v++) {                                                                               \
+            same[v] = 0;                                                                                            \
+            for (int w = 0; w < (W); w++)                                                                           \
+                same[v] += __builtin_popcountll(adj[v][w] & class[(int) colors[v]][w]);                             \
+            total += same[v];                                                                                       \
+            if (same[v] > 0) {                                                                                      \
+                bad[v >> 6] |= UINT64_C(1) << (v & 63);                                                             \
+                badN++;                                                                                             \
+            }                                                                                                       \
+        }                                                                                                           \
+        total /= 2;                                                                                                 \
+        int record = total;                                                                                         \
+        if (total < best) {                                                                                         \
+            best = total;                                                                                           \
+            if (report(colors, best) != 0)                                                                          \
+                return 0;                                                                                           \
+        } else if (report(NULL, 0) != 0)                                                                            \
+            return 0;                                                                                               \
+                                                                                                                    \
+        for (long move = 1, last = 0; total > 0 && move - last <= STALL_MOVES; move++) {                            \
+            int index = drawColor(&state, badN), w = 0;                                                             \
+            while (w < (W) - 1 && index >= __builtin_popcountll(bad[w]))                                            \
+                index -= __builtin_popcountll(bad[w++]);                                                            \
+            uint64_t pick = bad[w];                                                                                 \
+            while (index-- > 0)                                                                                     \
+                pick &= pick - 1;                                                                                   \
+            const int V = 64 * w + __builtin_ctzll(pick), OLD = colors[V];                                          \
+                                                                                                                    \
+            int count[K], color = -1, least = INT_MAX, ties = 0;                                                    \
+            for (int c = 0; c < (K); c++) {                                                                         \
+                count[c] = 0;                                                                                       \
+                for (int x = 0; x < (W); x++)                                                                       \
+                    count[c] += __builtin_popcountll(adj[V][x] & class[c][x]);                                      \
+                const int AFTER = total - same[V] + count[c];                                                       \
+                if (c != OLD && tabu[V][c] > move && AFTER >= best)                                                 \
+                    continue;                                                                                       \
+                if (AFTER < least) {                                                                                \
+                    least = AFTER;                                                                                  \
+                    color = c;                                                                                      \
+                    ties = 1;                                                                                       \
+                } else if (AFTER == least && drawColor(&state, ++ties) == 0)                                        \
+                    color = c;                                                                                      \
+            }                                                                                                       \
+            if (drawColor(&state, WALK_ODDS) == 0) {                                                                \
+                color = drawColor(&state, K);                                                                       \
+                least = total - same[V] + count[color];                                                             \
+            }                                                                                                       \
+            if (color != OLD) {                                                                                     \
+                tabu[V][OLD] = move + drawColor(&state, 10) + (6 * badN) / 10;                                      \
+                for (int x = 0; x < (W); x++) {                                                                     \
+                    for (uint64_t bits = adj[V][x] & class[OLD][x]; bits != 0; bits &= bits - 1) {                  \
+                        if (--same[64 * x + __builtin_ctzll(bits)] == 0) {                                          \
+                            bad[x] &= ~(bits & -bits);                                                              \
+                            badN--;                                                                                 \
+                        }                                                                                           \
+                    }                                                                                               \
+                    for (uint64_t bits = adj[V][x] & class[color][x]; bits != 0; bits &= bits - 1) {                \
+                        if (same[64 * x + __builtin_ctzll(bits)]++ == 0) {                                          \
+                            bad[x] |= bits & -bits;                                                                 \
+                            badN++;                                                                                 \
+                        }                                                                                           \
+                    }                                                                                               \
+                }                                                                                                   \
+                const uint64_t BIT = UINT64_C(1) << (V & 63);                                                       \
+                class[OLD][V >> 6] &= ~BIT;                                                                         \
+                class[color][V >> 6] |= BIT;                                                                        \
+                colors[V] = color;                                                                                  \
+                if ((same[V] > 0) != (count[color] > 0)) {                                                          \
+                    bad[V >> 6] ^= BIT;                                                                             \
+                    badN += count[color] > 0 ? 1 : -1;                                                              \
+                }                                                                                                   \
+                same[V] = count[color];                                                                             \
+                total = least;                                                                                      \
+            }                                                                                                       \
+                                                                                                                    \
+            if (total < record) {                                                                                   \
+                record = total;                                                                                     \
+                last = move;                                                                                        \
+            }                                                                                                       \
+            if (total < best) {                                                                                     \
+                best = total;                                                                                       \
+                if (report(colors, best) != 0)                                                                      \
+                    return 0;                                                                                       \
+            } else if (move % POLL_MOVES == 0 && report(NULL, 0) != 0)                                              \
+                return 0;                                                                                           \
+        }                                                                                                           \
+    }                                                                                                               \
+}
+
+DEFINE_SMALL_SEARCH(1, 2)
+DEFINE_SMALL_SEARCH(1, 3)
+DEFINE_SMALL_SEARCH(1, 4)
+DEFINE_SMALL_SEARCH(1, 5)
+DEFINE_SMALL_SEARCH(1, 6)
+DEFINE_SMALL_SEARCH(1, 7)
+DEFINE_SMALL_SEARCH(1, 8)
+DEFINE_SMALL_SEARCH(2, 2)
+DEFINE_SMALL_SEARCH(2, 3)
+DEFINE_SMALL_SEARCH(2, 4)
+DEFINE_SMALL_SEARCH(2, 5)
+DEFINE_SMALL_SEARCH(2, 6)
+DEFINE_SMALL_SEARCH(2, 7)
+DEFINE_SMALL_SEARCH(2, 8)
+
+static int smallSearch(const graph_t *g, scored_fn report) {
+    static int (*const SEARCH[2][MAX_COLORS + 1])(const graph_t *, scored_fn) = {
+        {NULL, NULL, smallSearch1_2, smallSearch1_3, smallSearch1_4, smallSearch1_5, smallSearch1_6, smallSearch1_7,
+            smallSearch1_8},
+        {NULL, NULL, smallSearch2_2, smallSearch2_3, smallSearch2_4, smallSearch2_5, smallSearch2_6, smallSearch2_7,
+            smallSearch2_8}
+    };
+    return SEARCH[g->nodeN > 64][getColorCount()](g, report);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file dense.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A bit matrix representation for dense graphs, on which colorings are searched without the edge list.
+ *
+ * @details Every node has a row of bits for its neighbors and every color a bitset of the nodes it holds. The
+ * conflicts of node v with color c are the population count of the row of v and the set of c, so a full evaluation
+ * takes O(V^2 / 64) word operations instead of O(E), and loading a coloring only sets one bit per node. Graphs with
+ * more than DENSE_PERCENT percent of all possible edges and at most DENSE_NODES nodes are kept this way. The rows of
+ * large graphs are evaluated on multiple threads.
+ *
+ * The search on large graphs is a min-conflicts walk with a tabu list: a random conflicting node takes the color with
+ * the fewest neighbors, found by one population count per color, and recoloring it moves one bit between two classes
+ * and updates the conflict counts of the neighbors in the two classes, so a move takes O(V / 64) instead of O(deg).
+ *
+ * The random mode takes this search for every graph of at most SMALL_NODES nodes, sparse or dense. Its walk is
+ * specialized at compile time for rows of one and of two words and for every number of colors from 2 to MAX_COLORS.
+ * The rows, classes, conflict counts and tabu list live on the stack, and every loop over a row or the colors has a
+ * constant trip count and unrolls, both in the evaluation of the colors of a node and in the update of a move. Random
+ * start colors are drawn straight into the color classes.
+ */
+
+#pragma once
+#include <stdint.h>
+#include "graph.h"
+
+#define DENSE_PERCENT   10      /**< The minimum density in percent of the graphs kept as bit matrix. */
+#define DENSE_NODES     16384   /**< The maximum number of nodes of a bit matrix, which then takes 32 MiB. */
+#define SMALL_NODES     128     /**< The maximum number of nodes of the specialized searches. */
+#define STALL_MOVES     100000  /**< The number of moves without a new best after which a run restarts. */
+
+typedef struct dense {          /**< A graph as bit matrix together with the color classes of a coloring. */
+    int nodeN;                  /**< The number of nodes. */
+    int words;                  /**< The number of 64 bit words of a row. */
+    uint64_t *adj;              /**< adj[v*words+w] holds the neighbors 64*w to 64*w+63 of node v. */
+    uint64_t *class;            /**< class[c*words+w] holds the nodes 64*w to 64*w+63 colored c. */
+} dense_t;
+
+/**
+ * @brief The callback through which the dense search hands colorings to the generator.
+ *
+ * @param colors    The coloring or NULL to only poll.
+ * @param conflicts The number of conflicting edges of the coloring.
+ * @return Returns non-zero if the search should stop.
+ */
+typedef int (*scored_fn)(const char *colors, int conflicts);
+
+/**
+ * @brief Check whether a graph should be kept as bit matrix.
+ *
+ * @param nodeN The number of nodes.
+ * @param edgeN The number of edges without self-loops and duplicates.
+ * @return Returns non-zero if the graph has more than one and at most DENSE_NODES nodes and more than DENSE_PERCENT
+ * percent of all possible edges.
+ */
+int isDense(int nodeN, int edgeN);
+
+/**
+ * @brief Build the bit matrix of a graph.
+ *
+ * @param d The bit matrix which should be initialized.
+ * @param g The graph.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int initDense(dense_t *d, const graph_t *g);
+
+/**
+ * @brief Free a bit matrix.
+ *
+ * @param d The bit matrix.
+ */
+void freeDense(dense_t *d);
+
+/**
+ * @brief Load a coloring into the color classes and count its conflicting edges.
+ *
+ * @param d         The bit matrix.
+ * @param colors    The coloring.
+ * @return Returns the number of conflicting edges.
+ */
+int loadDense(dense_t *d, const char *colors);
+
+/**
+ * @brief Search colorings on the bit matrix until the callback requests termination.
+ *
+ * @details Every run starts from a coloring of the selected construction and is restarted after STALL_MOVES moves
+ * without a new best. Only colorings with less conflicts than all colorings before are submitted, the callback is
+ * polled with NULL in between. Graphs of up to 64 and up to 128 nodes are searched by the specialized kernels.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings together with their conflicts.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int denseSearch(const graph_t *g, scored_fn report);
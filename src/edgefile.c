@@ -0,0 +1,784 @@
+/**
+ * @file edgefile.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Reading edge lists from files which are too large for the command line.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <semaphore.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include "parallel.h"
+#include "edgefile.h"
+
+#define CHUNK_LEN   (1 << 22)   /**< The size of a read buffer. */
+#define INPUT_LEN   (1 << 18)   /**< The size of the buffer for compressed input. */
+#define MAGIC_LEN   4           /**< The number of bytes which identify the compression format. */
+#define BYTES_PER_THREAD (1 << 24)  /**< The minimum number of bytes of a mapped file which justify another thread. */
+#define BATCH_LEN   4096        /**< The number of edges handed to the callback at once. */
+
+enum char_class {   /**< The classes of input bytes. */
+    CHAR_OTHER,     /**< A byte which may not appear in an edge file. */
+    CHAR_DIGIT,     /**< A decimal digit. */
+    CHAR_DASH,      /**< The dash between two node numbers. */
+    CHAR_BLANK,     /**< A space, tab or carriage return. */
+    CHAR_NEWLINE,   /**< A line feed. */
+    CHAR_HASH       /**< The start of a comment. */
+};
+
+enum codec {       /**< The compression formats of edge files. */
+    CODEC_PLAIN,    /**< Uncompressed. */
+    CODEC_GZIP,     /**< gzip, possibly several concatenated members. */
+    CODEC_ZSTD      /**< Zstandard, possibly several concatenated frames. */
+};
+
+enum scan_state {   /**< The states of the edge parser. */
+    SCAN_BLANK,     /**< Between edges. */
+    SCAN_FIRST,     /**< Within the first node number. */
+    SCAN_GAP,       /**< Between two node numbers separated by blanks. */
+    SCAN_DASH,      /**< After the dash. */
+    SCAN_SECOND,    /**< Within the second node number. */
+    SCAN_COMMENT    /**< Within a comment. */
+};
+
+typedef struct scanner {        /**< The state of the edge parser, carried across chunks. */
+    enum scan_state state;      /**< The current state. */
+    long u;                     /**< The first node number parsed so far. */
+    long v;                     /**< The second node number parsed so far. */
+    long line;                  /**< The current line number starting from 1. */
+    int nodeN;                  /**< The number of nodes seen so far. */
+    int batchN;                 /**< The number of edges in the batch. */
+    struct edge batch[BATCH_LEN];   /**< The edges which have not been handed to the callback yet. */
+} scanner_t;
+
+typedef struct reader {         /**< The double-buffered input of the reader thread. */
+    int fd;                     /**< The file descriptor. */
+    enum codec codec;           /**< The compression format of the file. */
+    unsigned char *in;          /**< The raw input which has been read but not decoded yet. */
+    size_t inPos;               /**< The index of the first byte of in which has not been decoded. */
+    size_t inLen;               /**< The number of bytes in in. */
+    int done;                   /**< Set while the decoder is between two gzip members or zstd frames. */
+#ifdef HAVE_ZLIB
+    z_stream gz;                /**< The gzip decoder. */
+#endif
+#ifdef HAVE_ZSTD
+    ZSTD_DStream *zs;           /**< The zstd decoder. */
+#endif
+    char *buf[2];               /**< The two chunk buffers. */
+    ssize_t len[2];             /**< The number of bytes in each buffer, 0 at the end of the file and -1 on errors. */
+    int err[2];                 /**< The errno of a failed read. */
+    sem_t empty[2];             /**< Posted when a buffer may be refilled. */
+    sem_t full[2];              /**< Posted when a buffer has been filled. */
+    int stop;                   /**< Set when the parser stops early. Accessed atomically. */
+} reader_t;
+
+typedef struct edge_list {  /**< A growing edge array. */
+    struct edge *edges;     /**< The edges. */
+    int n;                  /**< The number of edges. */
+    int cap;                /**< The capacity of the array. */
+} edge_list_t;
+
+typedef struct piece {      /**< A chunk of a mapped file and the edges parsed from it by one thread. */
+    const char *from;       /**< The first byte, which starts a line. */
+    const char *to;         /**< The byte after the last one, which starts a line or ends the file. */
+    edge_list_t list;       /**< The edges of the chunk. */
+    size_t at;              /**< The index of the first edge of the chunk in the merged array. */
+    long lines;             /**< The number of line feeds before the end of the chunk or the parse error. */
+    int nodeN;              /**< The number of nodes seen in the chunk. */
+    int status;             /**< 0 on success, -1 if memory could not be allocated and -2 on a parse error. */
+} piece_t;
+
+typedef struct mapped {     /**< A mapped file split into chunks. */
+    int pieceN;             /**< The number of chunks. */
+    piece_t piece[MAX_THREADS]; /**< The chunks. */
+    struct edge *edges;     /**< The merged edge array. */
+} mapped_t;
+
+static const unsigned char gzipMagic[2] = {0x1f, 0x8b};                 /**< The first bytes of a gzip file. */
+static const unsigned char zstdMagic[MAGIC_LEN] = {0x28, 0xb5, 0x2f, 0xfd};   /**< The first bytes of a zstd frame. */
+static unsigned char charClass[256];    /**< The class of every byte. Filled on first use. */
+
+/**
+ * @brief Fill the byte class table.
+ */
+static void initCharClass(void);
+
+/**
+ * @brief Detect the compression format from the first bytes of the file and set up its decoder.
+ *
+ * @param r The reader whose file is open and whose input buffer is allocated.
+ * @return Returns 0 on success and -1 if the file could not be read or its format is not supported (errno is set).
+ */
+static int openCodec(reader_t *r);
+
+/**
+ * @brief Release the decoder of a reader.
+ *
+ * @param r The reader.
+ */
+static void closeCodec(reader_t *r);
+
+/**
+ * @brief Append raw bytes of the file to the input buffer, moving the undecoded bytes to its start first.
+ *
+ * @param r The reader.
+ * @return Returns the number of bytes read, 0 at the end of the file and -1 on errors (errno is set).
+ */
+static ssize_t fillInput(reader_t *r);
+
+/**
+ * @brief Decode the next bytes of the file.
+ *
+ * @param r     The reader.
+ * @param out   The buffer where the decoded bytes should be stored.
+ * @param cap   The size of the buffer.
+ * @return Returns the number of decoded bytes, 0 at the end of the file and -1 if the file could not be read or is
+ * corrupt (errno is set).
+ */
+static ssize_t decodeInput(reader_t *r, char *out, size_t cap);
+
+/**
+ * @brief Fill the chunk buffers alternately until the end of the file. Runs as a thread.
+ *
+ * @param arg   The reader_t.
+ * @return Returns NULL.
+ */
+static void *readChunks(void *arg);
+
+/**
+ * @brief Parse the chunks of the reader thread until the end of the file or the first error.
+ *
+ * @param r     The reader whose file is open and whose buffers are allocated.
+ * @param sc    The initialized parser state.
+ * @param fn    The callback for the edge batches.
+ * @param arg   The argument passed to the callback.
+ * @return Returns the number of nodes on success, -1 if the file could not be read (errno is set), -2 on a parse
+ * error and -3 if the callback stopped the scan.
+ */
+static int scanChunks(reader_t *r, scanner_t *sc, edges_fn fn, void *arg);
+
+/**
+ * @brief Parse a chunk of the input.
+ *
+ * @param sc    The parser state.
+ * @param data  The chunk.
+ * @param len   The length of the chunk.
+ * @param fn    The callback for full batches.
+ * @param arg   The argument passed to the callback.
+ * @return Returns 0 on success, -2 on a parse error and -3 if the callback stopped the scan.
+ */
+static int scanChunk(scanner_t *sc, const char *data, size_t len, edges_fn fn, void *arg);
+
+/**
+ * @brief Append the parsed edge to the batch and hand the batch over when it is full.
+ *
+ * @param sc    The parser state.
+ * @param fn    The callback.
+ * @param arg   The argument passed to the callback.
+ * @return Returns 0 on success and -3 if the callback stopped the scan.
+ */
+static int emitEdge(scanner_t *sc, edges_fn fn, void *arg);
+
+/**
+ * @brief Read all edges of a mapped uncompressed file, parsing chunks of it on multiple threads.
+ *
+ * @details The file is split into one chunk per thread at line feeds, so that the chunks parse independently. The
+ * line number of an error is the number of line feeds in the preceding chunks plus those before the error.
+ *
+ * @param data  The mapped file.
+ * @param len   The length of the file.
+ * @param edges The address where the allocated edge array should be stored.
+ * @param edgeN The address where the number of edges should be stored.
+ * @param line  The address where the line number of a parse error should be stored.
+ * @return Returns the number of nodes on success, -1 if memory could not be allocated and -2 on a parse error.
+ */
+static int parseMapped(const char *data, size_t len, struct edge **edges, int *edgeN, long *line);
+
+/**
+ * @brief Parse a range of chunks of a mapped file. Implements range_fn.
+ *
+ * @param arg       The mapped_t.
+ * @param from      The first chunk.
+ * @param to        The chunk after the last one.
+ * @param thread    The index of the thread.
+ */
+static void parsePieces(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Parse a chunk of a mapped file into its edge list.
+ *
+ * @details Unlike scanChunk() this scanner works on whole tokens: the node numbers are read in tight digit loops and
+ * the chunk is known to end at a line boundary, so no state is carried across calls.
+ *
+ * @param pc    The chunk.
+ */
+static void parsePiece(piece_t *pc);
+
+/**
+ * @brief Read a node number.
+ *
+ * @param pos   The address of the position of the first digit, which is advanced past the number.
+ * @param end   The end of the input.
+ * @return Returns the number or -1 if there is no digit or the number is too large.
+ */
+static long scanNumber(const unsigned char **pos, const unsigned char *end);
+
+/**
+ * @brief Copy the edges of a range of chunks into the merged array. Implements range_fn.
+ *
+ * @param arg       The mapped_t.
+ * @param from      The first chunk.
+ * @param to        The chunk after the last one.
+ * @param thread    The index of the thread.
+ */
+static void mergePieces(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Make room for more edges in a growing array.
+ *
+ * @param list  The array.
+ * @param n     The number of edges which should fit after the current ones.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int reserveEdges(edge_list_t *list, int n);
+
+/**
+ * @brief Append a batch of edges to a growing array. Implements edges_fn.
+ *
+ * @param arg   The edge_list_t.
+ * @param batch The edges.
+ * @param n     The number of edges.
+ * @return Returns non-zero if memory could not be allocated.
+ */
+static int appendEdges(void *arg, const struct edge *batch, int n);
+
+
+int scanEdgeFile(const char *path, edges_fn fn, void *arg, long *line) {
+    initCharClass();
+    reader_t r;
+    memset(&r, 0, sizeof(r));
+    r.fd = open(path, O_RDONLY);
+    if (r.fd < 0)
+        return -1;
+    posix_fadvise(r.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    r.in = malloc(INPUT_LEN);
+    r.buf[0] = malloc(CHUNK_LEN);
+    r.buf[1] = malloc(CHUNK_LEN);
+    scanner_t *sc = malloc(sizeof(scanner_t));
+
+    int status = -1;
+    if (r.in == NULL || r.buf[0] == NULL || r.buf[1] == NULL || sc == NULL)
+        errno = ENOMEM;
+    else if (openCodec(&r) == 0) {
+        memset(sc, 0, offsetof(scanner_t, batch));
+        sc->line = 1;
+        status = scanChunks(&r, sc, fn, arg);
+        *line = sc->line;
+        closeCodec(&r);
+    }
+
+    const int ERR = errno;
+    close(r.fd);
+    errno = ERR;
+    free(r.in);
+    free(r.buf[0]);
+    free(r.buf[1]);
+    free(sc);
+    return status;
+}
+
+int loadEdgeFile(const char *path, struct edge **edges, int *edgeN, long *line) {
+    initCharClass();
+    const int FD = open(path, O_RDONLY);
+    if (FD < 0)
+        return -1;
+    struct stat st;
+    if (fstat(FD, &st) == 0 && S_ISREG(st.st_mode) && st.st_size >= MAGIC_LEN) {
+        const size_t LEN = st.st_size;
+        char *data = mmap(NULL, LEN, PROT_READ, MAP_PRIVATE, FD, 0);
+        if (data != MAP_FAILED && memcmp(data, gzipMagic, sizeof(gzipMagic)) != 0
+                && memcmp(data, zstdMagic, sizeof(zstdMagic)) != 0) {
+            posix_madvise(data, LEN, POSIX_MADV_WILLNEED);
+            const int NODE_N = parseMapped(data, LEN, edges, edgeN, line);
+            munmap(data, LEN);
+            close(FD);
+            if (NODE_N == -1)
+                errno = ENOMEM;
+            return NODE_N;
+        }
+        if (data != MAP_FAILED)
+            munmap(data, LEN);
+    }
+    close(FD);
+
+    edge_list_t list = {NULL, 0, 0};
+    int nodeN = scanEdgeFile(path, appendEdges, &list, line);
+    if (nodeN == -3) {
+        errno = ENOMEM;
+        nodeN = -1;
+    }
+    if (nodeN < 0) {
+        free(list.edges);
+        return nodeN;
+    }
+    *edges = list.edges;
+    *edgeN = list.n;
+    return nodeN;
+}
+
+
+static void initCharClass(void) {
+    if (charClass['0'] == CHAR_DIGIT)
+        return;
+    for (int c = '0'; c <= '9'; c++)
+        charClass[c] = CHAR_DIGIT;
+    charClass['-'] = CHAR_DASH;
+    charClass[' '] = CHAR_BLANK;
+    charClass['\t'] = CHAR_BLANK;
+    charClass['\r'] = CHAR_BLANK;
+    charClass['\n'] = CHAR_NEWLINE;
+    charClass['#'] = CHAR_HASH;
+}
+
+static int openCodec(reader_t *r) {
+    while (r->inLen < MAGIC_LEN) {
+        const ssize_t N = fillInput(r);
+        if (N < 0)
+            return -1;
+        if (N == 0)
+            break;
+    }
+    if (r->inLen >= sizeof(gzipMagic) && memcmp(r->in, gzipMagic, sizeof(gzipMagic)) == 0) {
+#ifdef HAVE_ZLIB
+        r->codec = CODEC_GZIP;
+        if (inflateInit2(&r->gz, 16 + MAX_WBITS) != Z_OK) {
+            errno = ENOMEM;
+            return -1;
+        }
+        return 0;
+#else
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+    if (r->inLen >= sizeof(zstdMagic) && memcmp(r->in, zstdMagic, sizeof(zstdMagic)) == 0) {
+#ifdef HAVE_ZSTD
+        r->codec = CODEC_ZSTD;
+        r->zs = ZSTD_createDStream();
+        if (r->zs == NULL) {
+            errno = ENOMEM;
+            return -1;
+        }
+        ZSTD_initDStream(r->zs);
+        return 0;
+#else
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+    r->codec = CODEC_PLAIN;
+    return 0;
+}
+
+static void closeCodec(reader_t *r) {
+#ifdef HAVE_ZLIB
+    if (r->codec == CODEC_GZIP)
+        inflateEnd(&r->gz);
+#endif
+#ifdef HAVE_ZSTD
+    if (r->codec == CODEC_ZSTD)
+        ZSTD_freeDStream(r->zs);
+#endif
+}
+
+static ssize_t fillInput(reader_t *r) {
+    if (r->inPos > 0) {
+        memmove(r->in, r->in + r->inPos, r->inLen - r->inPos);
+        r->inLen -= r->inPos;
+        r->inPos = 0;
+    }
+    for (;;) {
+        const ssize_t N = read(r->fd, r->in + r->inLen, INPUT_LEN - r->inLen);
+        if (N < 0 && errno == EINTR)
+            continue;
+        if (N > 0)
+            r->inLen += N;
+        return N;
+    }
+}
+
+static ssize_t decodeInput(reader_t *r, char *out, size_t cap) {
+    if (r->codec == CODEC_PLAIN) {
+        if (r->inPos < r->inLen) {
+            const size_t N = r->inLen - r->inPos < cap ? r->inLen - r->inPos : cap;
+            memcpy(out, r->in + r->inPos, N);
+            r->inPos += N;
+            return N;
+        }
+        for (;;) {
+            const ssize_t N = read(r->fd, out, cap);
+            if (N >= 0 || errno != EINTR)
+                return N;
+        }
+    }
+
+    size_t len = 0;
+    for (;;) {
+#ifdef HAVE_ZLIB
+        if (r->codec == CODEC_GZIP) {
+            r->gz.next_in = r->in + r->inPos;
+            r->gz.avail_in = r->inLen - r->inPos;
+            r->gz.next_out = (unsigned char *) out;
+            r->gz.avail_out = cap;
+            const int STATUS = inflate(&r->gz, Z_NO_FLUSH);
+            const size_t USED = r->inLen - r->inPos - r->gz.avail_in;
+            r->inPos += USED;
+            len = cap - r->gz.avail_out;
+            if (STATUS == Z_STREAM_END) {
+                r->done = 1;
+                inflateReset(&r->gz);
+            } else if (STATUS != Z_OK && STATUS != Z_BUF_ERROR) {
+                errno = EBADMSG;
+                return -1;
+            } else if (USED > 0)
+                r->done = 0;
+        }
+#endif
+#ifdef HAVE_ZSTD
+        if (r->codec == CODEC_ZSTD) {
+            ZSTD_inBuffer src = {r->in + r->inPos, r->inLen - r->inPos, 0};
+            ZSTD_outBuffer dst = {out, cap, 0};
+            const size_t HINT = ZSTD_decompressStream(r->zs, &dst, &src);
+            if (ZSTD_isError(HINT)) {
+                errno = EBADMSG;
+                return -1;
+            }
+            r->inPos += src.pos;
+            len = dst.pos;
+            if (HINT == 0)
+                r->done = 1;
+            else if (src.pos > 0)
+                r->done = 0;
+        }
+#endif
+        if (len > 0)
+            return len;
+        if (r->inPos < r->inLen)
+            continue;
+        const ssize_t N = fillInput(r);
+        if (N < 0)
+            return -1;
+        if (N == 0 && r->done)
+            return 0;
+        if (N == 0) {
+            errno = EBADMSG;
+            return -1;
+        }
+    }
+}
+
+static int scanChunks(reader_t *r, scanner_t *sc, edges_fn fn, void *arg) {
+    pthread_t tid;
+    for (int i = 0; i < 2; i++) {
+        sem_init(&r->empty[i], 0, 1);
+        sem_init(&r->full[i], 0, 0);
+    }
+    int status = pthread_create(&tid, NULL, readChunks, r);
+    if (status != 0) {
+        errno = status;
+        return -1;
+    }
+
+    for (int i = 0;; i ^= 1) {
+        sem_wait(&r->full[i]);
+        if (r->len[i] <= 0) {
+            errno = r->err[i];
+            status = r->len[i] < 0 ? -1 : 0;
+            break;
+        }
+        status = scanChunk(sc, r->buf[i], r->len[i], fn, arg);
+        if (status < 0) {
+            __atomic_store_n(&r->stop, 1, __ATOMIC_RELAXED);
+            sem_post(&r->empty[0]);
+            sem_post(&r->empty[1]);
+            break;
+        }
+        sem_post(&r->empty[i]);
+    }
+    pthread_join(tid, NULL);
+    for (int i = 0; i < 2; i++) {
+        sem_destroy(&r->empty[i]);
+        sem_destroy(&r->full[i]);
+    }
+
+    if (status == 0 && sc->state == SCAN_SECOND)
+        status = emitEdge(sc, fn, arg);
+    else if (status == 0 && sc->state != SCAN_BLANK && sc->state != SCAN_COMMENT)
+        status = -2;
+    if (status == 0 && sc->batchN > 0 && fn(arg, sc->batch, sc->batchN) != 0)
+        status = -3;
+    return status < 0 ? status : sc->nodeN;
+}
+
+static void *readChunks(void *arg) {
+    reader_t *r = arg;
+    for (int i = 0;; i ^= 1) {
+        sem_wait(&r->empty[i]);
+        if (__atomic_load_n(&r->stop, __ATOMIC_RELAXED))
+            break;
+
+        ssize_t len = 0;
+        while (len < CHUNK_LEN) {
+            const ssize_t N = decodeInput(r, r->buf[i] + len, CHUNK_LEN - len);
+            if (N < 0) {
+                r->err[i] = errno;
+                len = -1;
+            }
+            if (N <= 0)
+                break;
+            len += N;
+        }
+        r->len[i] = len;
+        sem_post(&r->full[i]);
+        if (len <= 0)
+            break;
+    }
+    return NULL;
+}
+
+static int scanChunk(scanner_t *sc, const char *data, size_t len, edges_fn fn, void *arg) {
+    for (size_t i = 0; i < len; i++) {
+        const enum char_class CLASS = charClass[(unsigned char) data[i]];
+        switch (sc->state) {
+        case SCAN_BLANK:
+            if (CLASS == CHAR_DIGIT) {
+                sc->u = data[i] - '0';
+                sc->state = SCAN_FIRST;
+            } else if (CLASS == CHAR_HASH)
+                sc->state = SCAN_COMMENT;
+            else if (CLASS != CHAR_BLANK && CLASS != CHAR_NEWLINE)
+                return -2;
+            break;
+        case SCAN_FIRST:
+            if (CLASS == CHAR_DIGIT) {
+                sc->u = 10 * sc->u + data[i] - '0';
+                if (sc->u > INT_MAX - 1)
+                    return -2;
+            } else if (CLASS == CHAR_DASH)
+                sc->state = SCAN_DASH;
+            else if (CLASS == CHAR_BLANK)
+                sc->state = SCAN_GAP;
+            else
+                return -2;
+            break;
+        case SCAN_GAP:
+        case SCAN_DASH:
+            if (CLASS == CHAR_DIGIT) {
+                sc->v = data[i] - '0';
+                sc->state = SCAN_SECOND;
+            } else if (CLASS != CHAR_BLANK || sc->state == SCAN_DASH)
+                return -2;
+            break;
+        case SCAN_SECOND:
+            if (CLASS == CHAR_DIGIT) {
+                sc->v = 10 * sc->v + data[i] - '0';
+                if (sc->v > INT_MAX - 1)
+                    return -2;
+                break;
+            }
+            if (CLASS != CHAR_BLANK && CLASS != CHAR_NEWLINE)
+                return -2;
+            if (emitEdge(sc, fn, arg) < 0)
+                return -3;
+            sc->state = SCAN_BLANK;
+            break;
+        case SCAN_COMMENT:
+            if (CLASS == CHAR_NEWLINE)
+                sc->state = SCAN_BLANK;
+            break;
+        }
+        sc->line += CLASS == CHAR_NEWLINE;
+    }
+    return 0;
+}
+
+static int emitEdge(scanner_t *sc, edges_fn fn, void *arg) {
+    sc->batch[sc->batchN].nodeU = sc->u;
+    sc->batch[sc->batchN++].nodeV = sc->v;
+    if (sc->u + 1 > sc->nodeN)
+        sc->nodeN = sc->u + 1;
+    if (sc->v + 1 > sc->nodeN)
+        sc->nodeN = sc->v + 1;
+    if (sc->batchN < BATCH_LEN)
+        return 0;
+    sc->batchN = 0;
+    return fn(arg, sc->batch, BATCH_LEN) != 0 ? -3 : 0;
+}
+
+static int parseMapped(const char *data, size_t len, struct edge **edges, int *edgeN, long *line) {
+    const size_t CHUNKS = len / BYTES_PER_THREAD;
+    mapped_t m;
+    m.pieceN = parallelThreads(CHUNKS < INT_MAX ? (int) CHUNKS : INT_MAX, 1);
+    const char *const END = data + len;
+    for (int p = 0; p < m.pieceN; p++) {
+        piece_t *pc = &m.piece[p];
+        memset(pc, 0, sizeof(*pc));
+        pc->from = p > 0 ? m.piece[p-1].to : data;
+        pc->to = END;
+        if (p < m.pieceN - 1) {
+            const char *cut = data + len / m.pieceN * (p + 1);
+            if (cut < pc->from)
+                cut = pc->from;
+            const char *nl = memchr(cut, '\n', END - cut);
+            pc->to = nl != NULL ? nl + 1 : END;
+        }
+    }
+    parallelFor(m.pieceN, 1, parsePieces, &m);
+
+    int status = 0, nodeN = 0;
+    size_t total = 0;
+    long lines = 1;
+    for (int p = 0; p < m.pieceN && status == 0; p++) {
+        const piece_t *PC = &m.piece[p];
+        status = PC->status;
+        lines += PC->lines;
+        m.piece[p].at = total;
+        total += PC->list.n;
+        if (PC->nodeN > nodeN)
+            nodeN = PC->nodeN;
+    }
+    *line = lines;
+    if (status == 0 && total > INT_MAX)
+        status = -1;
+    if (status == 0 && m.pieceN == 1) {
+        m.edges = m.piece[0].list.edges;
+        m.piece[0].list.edges = NULL;
+    } else if (status == 0) {
+        m.edges = malloc((total > 0 ? total : 1) * sizeof(struct edge));
+        if (m.edges != NULL)
+            parallelFor(m.pieceN, 1, mergePieces, &m);
+        else
+            status = -1;
+    }
+    for (int p = 0; p < m.pieceN; p++)
+        free(m.piece[p].list.edges);
+    if (status < 0)
+        return status;
+    *edges = m.edges;
+    *edgeN = total;
+    return nodeN;
+}
+
+static void parsePieces(void *arg, int from, int to, int thread) {
+    mapped_t *m = arg;
+    for (int p = from; p < to; p++)
+        parsePiece(&m->piece[p]);
+}
+
+static void parsePiece(piece_t *pc) {
+    const unsigned char *p = (const unsigned char *) pc->from, *const END = (const unsigned char *) pc->to;
+    if (reserveEdges(&pc->list, (END - p) / 8 < INT_MAX ? (int) ((END - p) / 8) : INT_MAX) < 0) {
+        pc->status = -1;
+        return;
+    }
+    while (p < END) {
+        const enum char_class CLASS = charClass[*p];
+        if (CLASS == CHAR_BLANK || CLASS == CHAR_NEWLINE) {
+            pc->lines += CLASS == CHAR_NEWLINE;
+            p++;
+            continue;
+        }
+        if (CLASS == CHAR_HASH) {
+            p = memchr(p, '\n', END - p);
+            if (p == NULL)
+                break;
+            continue;
+        }
+
+        const long U = scanNumber(&p, END);
+        if (U >= 0 && p < END && *p == '-')
+            p++;
+        else if (U >= 0 && p < END && charClass[*p] == CHAR_BLANK) {
+            while (p < END && charClass[*p] == CHAR_BLANK)
+                p++;
+        } else {
+            pc->status = -2;
+            return;
+        }
+        const long V = scanNumber(&p, END);
+        if (V < 0 || (p < END && charClass[*p] != CHAR_BLANK && charClass[*p] != CHAR_NEWLINE)) {
+            pc->status = -2;
+            return;
+        }
+
+        if (pc->list.n == pc->list.cap && reserveEdges(&pc->list, 1) < 0) {
+            pc->status = -1;
+            return;
+        }
+        pc->list.edges[pc->list.n].nodeU = U;
+        pc->list.edges[pc->list.n++].nodeV = V;
+        const int MAX = (U > V ? U : V) + 1;
+        if (MAX > pc->nodeN)
+            pc->nodeN = MAX;
+    }
+}
+
+static long scanNumber(const unsigned char **pos, const unsigned char *end) {
+    const unsigned char *p = *pos;
+    unsigned int digit;
+    if (p == end || (digit = *p - '0') > 9)
+        return -1;
+    long x = 0;
+    do {
+        x = 10 * x + digit;
+        if (x > INT_MAX - 1)
+            return -1;
+    } while (++p < end && (digit = *p - '0') <= 9);
+    *pos = p;
+    return x;
+}
+
+static void mergePieces(void *arg, int from, int to, int thread) {
+    mapped_t *m = arg;
+    for (int p = from; p < to; p++)
+        memcpy(&m->edges[m->piece[p].at], m->piece[p].list.edges, m->piece[p].list.n * sizeof(struct edge));
+}
+
+static int reserveEdges(edge_list_t *list, int n) {
+    if (list->n > INT_MAX - n)
+        return -1;
+    if (list->n + n <= list->cap)
+        return 0;
+    int cap = list->cap > 0 ? list->cap : BATCH_LEN;
+    while (cap < list->n + n)
+        cap = cap > INT_MAX / 2 ? INT_MAX : 2 * cap;
+    struct edge *edges = realloc(list->edges, (size_t) cap * sizeof(struct edge));
+    if (edges == NULL)
+        return -1;
+    list->edges = edges;
+    list->cap = cap;
+    return 0;
+}
+
+static int appendEdges(void *arg, const struct edge *batch, int n) {
+    edge_list_t *list = arg;
+    if (reserveEdges(list, n) < 0)
+        return 1;
+    memcpy(&list->edges[list->n], batch, n * sizeof(struct edge));
+    list->n += n;
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file edgefile.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Reading edge lists from files which are too large for the command line.
+ *
+ * @details An edge file holds the same edges as the command line: two non-negative node numbers joined by a dash,
+ * separated by whitespace. Two numbers separated by blanks on one line are accepted as an edge as well, so plain
+ * "U V" exports can be read directly, and lines starting with '#' are comments. The file is read in large chunks by
+ * a reader thread into two alternating buffers, so reading the next chunk overlaps parsing the current one. The
+ * parser is a byte-wise state machine which carries its state across chunk boundaries and hands the edges over in
+ * batches.
+ *
+ * Files compressed with gzip, or with zstd when the library was found at build time, are recognized by their first
+ * bytes and decompressed by the reader thread while it fills the buffers, so parsing overlaps decompression and no
+ * temporary file is written. Concatenated gzip members and zstd frames are read one after the other.
+ *
+ * loadEdgeFile() maps uncompressed regular files into memory instead and splits them at line feeds into one chunk
+ * per core. Every thread parses its chunk into its own edge array, and the arrays are concatenated at offsets given
+ * by the prefix sums of their lengths. Line numbers of parse errors are recovered the same way from the number of
+ * line feeds in each chunk.
+ */
+
+#pragma once
+#include "graph.h"
+
+/**
+ * @brief The callback which receives a batch of parsed edges.
+ *
+ * @param arg   The argument passed to scanEdgeFile().
+ * @param batch The edges.
+ * @param n     The number of edges.
+ * @return Returns non-zero if scanning should stop.
+ */
+typedef int (*edges_fn)(void *arg, const struct edge *batch, int n);
+
+/**
+ * @brief Stream all edges of a file through a callback.
+ *
+ * @param path  The path of the edge file.
+ * @param fn    The callback for the edge batches.
+ * @param arg   The argument passed to the callback.
+ * @param line  The address where the line number of a parse error should be stored.
+ * @return Returns the number of nodes on success, -1 if the file could not be read (errno is set), -2 on a parse
+ * error and -3 if the callback stopped the scan.
+ */
+int scanEdgeFile(const char *path, edges_fn fn, void *arg, long *line);
+
+/**
+ * @brief Read all edges of a file into an array.
+ *
+ * @param path  The path of the edge file.
+ * @param edges The address where the allocated edge array should be stored.
+ * @param edgeN The address where the number of edges should be stored.
+ * @param line  The address where the line number of a parse error should be stored.
+ * @return Returns the number of nodes on success, -1 if the file could not be read or memory could not be allocated
+ * and -2 on a parse error.
+ */
+int loadEdgeFile(const char *path, struct edge **edges, int *edgeN, long *line);
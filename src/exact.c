@@ -0,0 +1,228 @@
+/**
+ * @file exact.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief An exhaustive search which proves the minimum number of removed edges of a small graph.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include "parallel.h"
+#include "exact.h"
+
+#define POLL_STEPS  (1 << 20)   /**< The number of Gray code steps between two polls of the callback. */
+#define INNER_DIGITS 2          /**< The number of trailing digits minimized directly instead of being walked. */
+
+typedef struct enumeration {            /**< The state shared by the threads of the exhaustive search. */
+    int nodeN;                          /**< The number of relabeled nodes. */
+    int prefixN;                        /**< The number of digits fixed by each work item. */
+    uint32_t adj[EXACT_NODES];          /**< The adjacency bitmasks of the relabeled nodes. */
+    report_fn report;                   /**< The callback polled for termination. */
+    int found;                          /**< Set when a proper coloring was found. Accessed atomically. */
+    int quit;                           /**< Set when the callback ended the search. Accessed atomically. */
+    int best[MAX_THREADS];              /**< The fewest conflicts found by each thread. */
+    uint32_t bestClass[MAX_THREADS][COLORS];    /**< The color classes of the best coloring of each thread. */
+} enumeration_t;
+
+/**
+ * @brief Walk the colorings of a range of work items. Implements range_fn.
+ *
+ * @param arg       The enumeration_t.
+ * @param from      The first work item.
+ * @param to        The work item after the last one.
+ * @param thread    The index of the thread.
+ */
+static void enumerateItems(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Walk all colorings of the free digits of a work item in reflected Gray code order.
+ *
+ * @details Implements the loopless reflected mixed-radix Gray code (Knuth's algorithm H). The nodes of the first
+ * INNER_DIGITS free digits are left out of the walk. At every step their best colors are picked directly from
+ * their neighbor counts, which replaces the innermost 3^INNER_DIGITS steps by a few population counts.
+ *
+ * @param en        The shared state.
+ * @param item      The work item, whose base 3 digits are the colors of nodes 1 to prefixN.
+ * @param thread    The index of the thread.
+ * @return Returns non-zero if the search should stop.
+ */
+static int enumerateItem(enumeration_t *en, int item, int thread);
+
+/**
+ * @brief Find the best colors of the inner nodes for the colors of all other nodes.
+ *
+ * @param en    The shared state.
+ * @param class The color classes of the other nodes.
+ * @param first The first inner node.
+ * @param inner The number of inner nodes, at most INNER_DIGITS.
+ * @param pick  The address where the colors of the inner nodes should be stored as base 3 digits.
+ * @return Returns the number of conflicting edges at the inner nodes.
+ */
+static int innerMinimum(const enumeration_t *en, const uint32_t *class, int first, int inner, int *pick);
+
+
+int exhaustiveSearch(const graph_t *g, report_fn report, char *colors) {
+    enumeration_t en;
+    int label[EXACT_NODES], degree[EXACT_NODES];
+    memset(&en, 0, sizeof(en));
+    for (int v = 0; v < g->nodeN; v++) {
+        const int DEG = g->offset[v+1] - g->offset[v];
+        if (DEG == 0)
+            continue;
+        if (en.nodeN == EXACT_NODES)
+            return -2;
+        int i = en.nodeN++;
+        for (; i > 0 && degree[i-1] < DEG; i--) {
+            label[i] = label[i-1];
+            degree[i] = degree[i-1];
+        }
+        label[i] = v;
+        degree[i] = DEG;
+    }
+
+    for (int i = 0; i < en.nodeN; i++) {
+        cursor_t cur;
+        initCursor(&cur, g, label[i]);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            for (int j = 0; j < en.nodeN; j++) {
+                if (label[j] == u)
+                    en.adj[i] |= 1u << j;
+            }
+        }
+    }
+
+    en.prefixN = en.nodeN - 1 < PREFIX_DIGITS ? (en.nodeN > 0 ? en.nodeN - 1 : 0) : PREFIX_DIGITS;
+    en.report = report;
+    int items = 1;
+    for (int d = 0; d < en.prefixN; d++)
+        items *= COLORS;
+    for (int t = 0; t < MAX_THREADS; t++)
+        en.best[t] = INT_MAX;
+    parallelFor(items, 1, enumerateItems, &en);
+    if (en.quit && !en.found)
+        return -1;
+
+    int winner = 0;
+    for (int t = 1; t < MAX_THREADS; t++) {
+        if (en.best[t] < en.best[winner])
+            winner = t;
+    }
+    memset(colors, 0, g->nodeN);
+    for (int i = 0; i < en.nodeN; i++) {
+        for (int c = 1; c < COLORS; c++) {
+            if (en.bestClass[winner][c] >> i & 1)
+                colors[label[i]] = c;
+        }
+    }
+    return en.nodeN > 0 ? en.best[winner] : 0;
+}
+
+
+static void enumerateItems(void *arg, int from, int to, int thread) {
+    enumeration_t *en = arg;
+    for (int item = from; item < to; item++) {
+        if (__atomic_load_n(&en->quit, __ATOMIC_RELAXED) || __atomic_load_n(&en->found, __ATOMIC_RELAXED)
+                || enumerateItem(en, item, thread) != 0)
+            break;
+    }
+}
+
+static int enumerateItem(enumeration_t *en, int item, int thread) {
+    const int N = en->nodeN, FIRST = 1 + en->prefixN, DIGITS = N > FIRST ? N - FIRST : 0;
+    const int INNER = DIGITS < INNER_DIGITS ? DIGITS : INNER_DIGITS, FREE = FIRST + INNER, OUTER = DIGITS - INNER;
+    uint32_t class[COLORS] = {0, 0, 0};
+    int digit[EXACT_NODES], dir[EXACT_NODES], focus[EXACT_NODES + 1], best = en->best[thread];
+    class[0] = N > 0 ? 1 : 0;
+    for (int v = 1; v < N; v++) {
+        int c = 0;
+        if (v < FIRST) {
+            c = item % COLORS;
+            item /= COLORS;
+        } else if (v < FREE)
+            continue;
+        class[c] |= 1u << v;
+    }
+    int cost = 0;
+    for (int v = 0; v < N; v++) {
+        for (int c = 0; c < COLORS; c++) {
+            if (class[c] >> v & 1)
+                cost += __builtin_popcount(en->adj[v] & class[c]);
+        }
+    }
+    cost /= 2;
+
+    for (int j = 0; j <= OUTER; j++) {
+        digit[j] = 0;
+        dir[j] = 1;
+        focus[j] = j;
+    }
+    for (long step = 1;; step++) {
+        int pick;
+        const int TOTAL = cost + innerMinimum(en, class, FIRST, INNER, &pick);
+        if (TOTAL < best) {
+            best = en->best[thread] = TOTAL;
+            memcpy(en->bestClass[thread], class, sizeof(class));
+            for (int k = 0; k < INNER; k++, pick /= COLORS)
+                en->bestClass[thread][pick % COLORS] |= 1u << (FIRST + k);
+            if (best == 0) {
+                __atomic_store_n(&en->found, 1, __ATOMIC_RELAXED);
+                return 1;
+            }
+        }
+        if (step % POLL_STEPS == 0) {
+            if (en->report(NULL) != 0)
+                __atomic_store_n(&en->quit, 1, __ATOMIC_RELAXED);
+            if (__atomic_load_n(&en->quit, __ATOMIC_RELAXED) || __atomic_load_n(&en->found, __ATOMIC_RELAXED))
+                return 1;
+        }
+
+        const int J = focus[0];
+        focus[0] = 0;
+        if (J == OUTER)
+            return 0;
+        const int V = FREE + J, FROM = digit[J], TO = FROM + dir[J];
+        const uint32_t BIT = 1u << V;
+        class[FROM] &= ~BIT;
+        cost += __builtin_popcount(en->adj[V] & class[TO]) - __builtin_popcount(en->adj[V] & class[FROM]);
+        class[TO] |= BIT;
+        digit[J] = TO;
+        if (TO == 0 || TO == COLORS - 1) {
+            dir[J] = -dir[J];
+            focus[J] = focus[J+1];
+            focus[J+1] = J + 1;
+        }
+    }
+}
+
+static int innerMinimum(const enumeration_t *en, const uint32_t *class, int first, int inner, int *pick) {
+    int count[INNER_DIGITS][COLORS], best = INT_MAX;
+    for (int k = 0; k < inner; k++) {
+        for (int c = 0; c < COLORS; c++)
+            count[k][c] = __builtin_popcount(en->adj[first+k] & class[c]);
+    }
+    *pick = 0;
+    if (inner == 0)
+        return 0;
+    if (inner == 1) {
+        for (int a = 0; a < COLORS; a++) {
+            if (count[0][a] < best) {
+                best = count[0][a];
+                *pick = a;
+            }
+        }
+        return best;
+    }
+    const int SAME = en->adj[first] >> (first + 1) & 1;
+    for (int a = 0; a < COLORS; a++) {
+        for (int b = 0; b < COLORS; b++) {
+            const int COST = count[0][a] + count[1][b] + (SAME & (a == b));
+            if (COST < best) {
+                best = COST;
+                *pick = a + COLORS * b;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file exact.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief An exhaustive search which proves the minimum number of removed edges of a small graph.
+ *
+ * @details Nodes without edges are left out and the others are relabeled by decreasing degree. The first node keeps
+ * color 0, since swapping colors doesn't change the conflicts, and the remaining n-1 nodes are the digits of a
+ * ternary number. The colorings are walked in reflected ternary Gray code order, where each step changes one digit
+ * by one, so the conflict count changes by the neighbors of a single node in its new class minus those in its old
+ * class, two population counts over bitmasks. The leading PREFIX_DIGITS digits are fixed per work item, and the
+ * 3^PREFIX_DIGITS items are split across threads, each walking the remaining digits. A thread which finds a proper
+ * coloring stops the others.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define EXACT_NODES     25  /**< The maximum number of nodes with edges. The search takes 3^(n-1) steps. */
+#define PREFIX_DIGITS   4   /**< The number of digits fixed by each work item. */
+
+/**
+ * @brief Find a coloring with the minimum number of conflicts.
+ *
+ * @details The callback is only polled with NULL, possibly from several threads, and ends the search early if it
+ * returns non-zero.
+ *
+ * @param g         The graph.
+ * @param report    The callback which is polled for termination.
+ * @param colors    The buffer where an optimal coloring should be stored.
+ * @return Returns the minimum number of conflicting edges, -1 if the callback ended the search and -2 if more than
+ * EXACT_NODES nodes have edges.
+ */
+int exhaustiveSearch(const graph_t *g, report_fn report, char *colors);
@@ -18,13 +18,49 @@
 #include <unistd.h>
 #include <limits.h>
 #include "common.h"
+#include "graph.h"
+#include "weighted.h"
+#include "hea.h"
+#include "lns.h"
+#include "ils.h"
+#include "bp.h"
+#include "multilevel.h"
+#include "partition.h"
+#include "edgefile.h"
+#include "stream.h"
+#include "construct.h"
+#include "normalize.h"
+#include "exact.h"
+#include "count.h"
+#include "tree.h"
+#include "csp.h"
+#include "dense.h"
+#include "chromatic.h"
 
 // Global variables
-struct edge {   /**< The container for the parsed edge nodes. */
-    int nodeU;  /**< The node value wich is connected to nodeV */
-    int nodeV;  /**< The node value wich is connected to nodeU */
+enum mode {         /**< The search engines a generator can run. */
+    MODE_RANDOM,    /**< Independent random colorings. */
+    MODE_WEIGHTED,  /**< Breakout local search with shared edge weights. */
+    MODE_HEA,       /**< Hybrid evolutionary search on the elite pool. */
+    MODE_LNS,       /**< Large neighborhood search with exact region re-solves. */
+    MODE_ILS,       /**< Iterated local search with Luby restarts. */
+    MODE_BP,        /**< Belief propagation with decimation. */
+    MODE_ML,        /**< Multilevel coarsening and refinement. */
+    MODE_PART,      /**< Partitioned local search with one thread per part. */
+    MODE_STREAM,    /**< Semi-streaming passes over an edge file. */
+    MODE_EXACT,     /**< Exhaustive Gray code enumeration of small graphs. */
+    MODE_COUNT,     /**< Counting the proper colorings without a supervisor. */
+    MODE_TREE,      /**< Dynamic programming over a tree decomposition. */
+    MODE_CSP,       /**< Exact 3-colorability decision by branching on a constraint satisfaction problem. */
+    MODE_CHROMATIC  /**< Chromatic number search over a decreasing number of colors. */
 };
 
+static const graph_t *graph;    /**< The graph of the normalized edges. */
+static const edge_set_t *edgeSet;   /**< The normalized edges and the self-loops. */
+static const struct edge *parsed;   /**< The edges in input order, to which the normalized edges map back. */
+static char **edgeStr;          /**< The string representation of the edges or NULL if they were read from a file. */
+static int edgeOffset;          /**< The index of the first edge in edgeStr. */
+
 // Prototypes
 /**
  * @brief Write helpful usage information about the program to stderr.
@@ -76,23 +112,136 @@ static int parseEdges(struct edge *edges, char **str, int n, int offset, char **
 
 
 /**
- * @brief Generates a 3-coloring for the graph.
+ * @brief Generates a k-coloring for the graph.
  * 
- * @details Iterate through all edges and assigns random integers from the range of 1 to 3 to the nodes of an edge. 
- * Add the string representation of the edge to the output buffer if the assigned numbers are the same. If the buffer 
- * doesn't have enough space -1 is returned. On success 0 is returned. The return value indicates if a solution should 
- * be discarded.
+ * @details Iterate through all edges and assigns random integers from the range of 1 to k to the nodes of an edge. 
+ * Add the string representation of the edge to the output buffer if the assigned numbers are the same. The 
+ * self-loops are added first. If the buffer doesn't have enough space -1 is returned. On success 0 is returned. The 
+ * return value indicates if a solution should be discarded.
+ * Global variables: edgeSet.
  * 
  * @param nodes     The node array containing the assigned "colors".
  * @param nodeN     the size of the node array.
- * @param edges     The parsed edges array.
- * @param edgeN     The size of the parsed edges array.
- * @param edgeStr   The array containing the string representation of the edges.
- * @param offset    The starting index of the edgeStr array.
  * @param buf       The buffer where the solution should be safed at. Size of the buffer is MAX_LINE.
  * @return Returns 0 on success and -1 if the solution should be discarded.
  */
-static int generate3coloring(char *nodes, int nodeN, struct edge *edges, int edgeN, char **edgeStr, int offset, char *buf);
+static int generateColoring(char *nodes, int nodeN, char *buf);
+
+/**
+ * @brief Append the string representation of an input edge to a solution.
+ *
+ * @details Edges read from a file are written as U-V. Global variables: parsed, edgeStr, edgeOffset.
+ *
+ * @param buf   The solution buffer of size MAX_LINE.
+ * @param index The index of the edge in the input.
+ * @return Returns 0 on success and -1 if the buffer doesn't have enough space.
+ */
+static int appendEdge(char *buf, int index);
+
+/**
+ * @brief Write the conflicting edges of a coloring to a buffer.
+ *
+ * @details Add the string representation of every self-loop and of every edge whose nodes have the same color to 
+ * the buffer. If the buffer doesn't have enough space -1 is returned.
+ * Global variables: graph, edgeSet.
+ * 
+ * @param colors    The coloring.
+ * @param buf       The buffer where the solution should be safed at. Size of the buffer is MAX_LINE.
+ * @return Returns 0 on success and -1 if the solution should be discarded.
+ */
+static int formatSolution(const char *colors, char *buf);
+
+/**
+ * @brief Submit a coloring of a search engine to the supervisor.
+ * 
+ * @details Implements the report_fn callback. The coloring is discarded if its solution doesn't fit into the 
+ * circular buffer. If colors is NULL only the state flag is checked.
+ * Global variables: myshm.
+ * 
+ * @param colors    The coloring or NULL.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitColoring(const char *colors);
+
+/**
+ * @brief Submit a coloring whose conflicts were already counted to the supervisor.
+ * 
+ * @details Implements the scored_fn callback. The edges are only formatted if that many can fit into the circular
+ * buffer. If colors is NULL only the state flag is checked.
+ * Global variables: myshm, graph, edgeSet.
+ * 
+ * @param colors    The coloring or NULL.
+ * @param conflicts The number of conflicting edges of the coloring.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitScored(const char *colors, int conflicts);
+
+/**
+ * @brief Submit a solution of the semi-streaming search to the supervisor.
+ * 
+ * @details Implements the removed_fn callback. If edges is NULL only the state flag is checked.
+ * Global variables: myshm.
+ * 
+ * @param cost  The number of conflicting edges.
+ * @param edges The conflicting edges or NULL.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitRemoved(int cost, const char *edges);
+
+/**
+ * @brief Submit a coloring which is proven to be optimal to the supervisor.
+ * 
+ * @details The solution is written even if its removed edges don't fit into the circular buffer.
+ * Global variables: myshm, graph, edgeSet.
+ * 
+ * @param colors    The coloring.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitOptimum(const char *colors);
+
+/**
+ * @brief Submit a proven lower bound on the removed edges of every solution to the supervisor.
+ * 
+ * @details The solution carries no coloring and no edges. Global variables: myshm, edgeSet.
+ * 
+ * @param bound The lower bound.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitBound(int bound);
+
+/**
+ * @brief Submit proven bounds on the chromatic number to the supervisor.
+ * 
+ * @details Implements the bounds_fn callback. The solution carries no coloring and no edges. If both bounds are 0
+ * only the state flag is checked. Global variables: myshm, edgeSet.
+ * 
+ * @param lower The lower bound on the chromatic number.
+ * @param upper The number of colors of a proper coloring.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitBounds(int lower, int upper);
+
+/**
+ * @brief Offer a coloring of the evolutionary search to the elite pool.
+ * 
+ * @details Implements the report_fn callback. The coloring is attached to the solution and always written, even if 
+ * its removed edges don't fit into the circular buffer. If colors is NULL only the state flag is checked.
+ * Global variables: myshm, graph.
+ * 
+ * @param colors    The coloring or NULL.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int submitOffspring(const char *colors);
+
+/**
+ * @brief Write a solution to the circular buffer unless the supervisor asked the generators to terminate.
+ * 
+ * @details Global variables: myshm, sem_mutex, sem_free, sem_used.
+ * 
+ * @param sol   The solution.
+ * @return Returns non-zero if the generator should terminate.
+ */
+static int writeSolution(const solution_t *sol);
 
 /**
  * @brief Open an existing shared memory.
@@ -116,16 +265,15 @@ static int openSHM(myshm_t **myshm);
 static sem_t * openSEM(const char * sem_name);
 
 /**
- * @brief Write a string to the shared memory.
+ * @brief Write a solution to the shared memory.
  * 
- * @details Write a string to the shared memory under mutual exclusion. After writing to the shared memory 
- * increase the wirte index and print a debug message to stdout.
+ * @details Write a solution to the shared memory under mutual exclusion. The coloring is only copied if one is 
+ * attached. After writing to the shared memory increase the wirte index and print a debug message to stdout.
  * Global variables: myshm, myprog.
  * 
- * @param str   The string which sould be written to the shared memory.
- * @return return 0 on success otherwise return -1.
+ * @param sol   The solution which sould be written to the shared memory.
  */
-static void circ_buf_write(char *str);
+static void circ_buf_write(const solution_t *sol);
 
 /**
  * @brief Main function.
@@ -140,59 +288,240 @@ static void circ_buf_write(char *str);
 int main(int argc, char **argv) {
     myprog = argv[0];
 
-    if (getopt(argc, argv, "") != -1)
-        usage();
-    if (argc <= 1)
+    enum mode mode = MODE_RANDOM;
+    enum construction init = CONSTRUCT_RANDOM;
+    const char *path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "m:i:f:k:")) != -1) {
+        if (opt == 'f') {
+            path = optarg;
+            continue;
+        }
+        if (opt == 'k') {
+            char *end;
+            int status = 0;
+            const int K = parseNumber(optarg, &end, &status);
+            if (status < 0 || *end != '\0' || K < 2 || K > MAX_COLORS)
+                usage();
+            setColorCount(K);
+            continue;
+        }
+        if (opt == 'i') {
+            if (strcmp(optarg, "random") == 0)
+                init = CONSTRUCT_RANDOM;
+            else if (strcmp(optarg, "grasp") == 0)
+                init = CONSTRUCT_GRASP;
+            else if (strcmp(optarg, "prop") == 0)
+                init = CONSTRUCT_PROP;
+            else if (strcmp(optarg, "spectral") == 0)
+                init = CONSTRUCT_SPECTRAL;
+            else
+                usage();
+            continue;
+        }
+        if (opt != 'm')
+            usage();
+        if (strcmp(optarg, "random") == 0)
+            mode = MODE_RANDOM;
+        else if (strcmp(optarg, "weighted") == 0)
+            mode = MODE_WEIGHTED;
+        else if (strcmp(optarg, "hea") == 0)
+            mode = MODE_HEA;
+        else if (strcmp(optarg, "lns") == 0)
+            mode = MODE_LNS;
+        else if (strcmp(optarg, "ils") == 0)
+            mode = MODE_ILS;
+        else if (strcmp(optarg, "bp") == 0)
+            mode = MODE_BP;
+        else if (strcmp(optarg, "ml") == 0)
+            mode = MODE_ML;
+        else if (strcmp(optarg, "part") == 0)
+            mode = MODE_PART;
+        else if (strcmp(optarg, "stream") == 0)
+            mode = MODE_STREAM;
+        else if (strcmp(optarg, "exact") == 0)
+            mode = MODE_EXACT;
+        else if (strcmp(optarg, "count") == 0)
+            mode = MODE_COUNT;
+        else if (strcmp(optarg, "tree") == 0)
+            mode = MODE_TREE;
+        else if (strcmp(optarg, "csp") == 0)
+            mode = MODE_CSP;
+        else if (strcmp(optarg, "chromatic") == 0)
+            mode = MODE_CHROMATIC;
+        else
+            usage();
+    }
+    if ((path == NULL) == (argc <= optind) || (mode == MODE_STREAM && path == NULL))
         usage();
-
-    // Open shared memory
-    shmfd = openSHM(&myshm);
-    if (atexit(unmap_close_SHM) != 0)
-        error_exit("atexit() failed");
-    // Open semaphores
-    sem_used = openSEM(SEM_USED);
-    if (atexit(closeSemUsed) != 0)
-        error_exit("atexit() failed");
-    sem_free = openSEM(SEM_FREE);
-    if (atexit(closeSemFree) != 0)
-        error_exit("atexit() failed");
-    sem_mutex = openSEM(SEM_MUTEX);
-    if (atexit(closeSemMutex) != 0)
-        error_exit("atexit() failed");
-
-
-    char *ptr = NULL;
-    struct edge edges[argc-1];
-    const int NODE_NUM = parseEdges(edges, argv, argc, 1, &ptr);
-    if (NODE_NUM < 0 || ptr != NULL) {
-        const int L = 23 + strlen(ptr);
-        char errstr[L];
-        sprintf(errstr, "Failed to parse edge %s", ptr);
-        error_exit(errstr);
+    if (getColorCount() != COLORS && mode != MODE_RANDOM && mode != MODE_WEIGHTED && mode != MODE_ILS
+            && mode != MODE_ML)
+        error_exit("Only the random, weighted, ils and ml modes support other than 3 colors");
+
+    // Open shared memory, unless the count is printed directly
+    if (mode != MODE_COUNT) {
+        shmfd = openSHM(&myshm);
+        if (atexit(unmap_close_SHM) != 0)
+            error_exit("atexit() failed");
+        // Open semaphores
+        sem_used = openSEM(SEM_USED);
+        if (atexit(closeSemUsed) != 0)
+            error_exit("atexit() failed");
+        sem_free = openSEM(SEM_FREE);
+        if (atexit(closeSemFree) != 0)
+            error_exit("atexit() failed");
+        sem_mutex = openSEM(SEM_MUTEX);
+        if (atexit(closeSemMutex) != 0)
+            error_exit("atexit() failed");
+        sem_pool = openSEM(SEM_POOL);
+        if (atexit(closeSemPool) != 0)
+            error_exit("atexit() failed");
     }
 
-    char nodes[NODE_NUM];
-    char buf[MAX_LINE];
+
     srandom(getpid());
+    setConstruction(init);
+    long line = 0;
+    if (mode == MODE_STREAM) {
+        const int STATUS = streamingSearch(path, submitRemoved, &line);
+        if (STATUS == -2) {
+            char errstr[64];
+            snprintf(errstr, sizeof(errstr), "Failed to parse edge file at line %ld", line);
+            error_exit(errstr);
+        }
+        if (STATUS < 0)
+            error_exit("Failed to read edge file");
+        exit(EXIT_SUCCESS);
+    }
+
+    struct edge *edges = NULL;
+    int edgeNum = argc - optind, nodeNum;
+    if (path != NULL) {
+        nodeNum = loadEdgeFile(path, &edges, &edgeNum, &line);
+        if (nodeNum == -2) {
+            char errstr[64];
+            snprintf(errstr, sizeof(errstr), "Failed to parse edge file at line %ld", line);
+            error_exit(errstr);
+        }
+        if (nodeNum < 0)
+            error_exit("Failed to read edge file");
+        edgeStr = NULL;
+    } else {
+        char *ptr = NULL;
+        edges = malloc((edgeNum > 0 ? edgeNum : 1) * sizeof(struct edge));
+        if (edges == NULL)
+            error_exit("Failed to allocate edges");
+        nodeNum = parseEdges(edges, argv, argc, optind, &ptr);
+        if (nodeNum < 0 || ptr != NULL) {
+            const int L = 23 + strlen(ptr);
+            char errstr[L];
+            sprintf(errstr, "Failed to parse edge %s", ptr);
+            error_exit(errstr);
+        }
+        edgeStr = argv;
+        edgeOffset = optind;
+    }
+
+    edge_set_t set;
+    if (normalizeEdges(edges, edgeNum, &set) < 0)
+        error_exit("Failed to allocate edges");
+    edgeSet = &set;
+    parsed = edges;
+
+    const int BITS = nodeNum <= SMALL_NODES || isDense(nodeNum, set.edgeN);
+    if (mode != MODE_RANDOM || init != CONSTRUCT_RANDOM || path != NULL || BITS) {
+        graph_t g;
+        if (initGraph(&g, set.edges, set.edgeN, nodeNum) < 0)
+            error_exit("Failed to allocate graph");
+        graph = &g;
+
+        int status = 0;
+        if (mode == MODE_RANDOM && BITS)
+            status = denseSearch(&g, submitScored);
+        else if (mode == MODE_RANDOM)
+            status = constructiveSearch(&g, submitColoring);
+        else if (mode == MODE_WEIGHTED)
+            status = weightedSearch(&g, submitColoring);
+        else if (mode == MODE_HEA) {
+            if (nodeNum > POOL_NODES)
+                error_exit("Graph has too many nodes for the elite pool");
+            status = evolutionarySearch(&g, submitOffspring);
+        } else if (mode == MODE_LNS)
+            status = neighborhoodSearch(&g, submitColoring);
+        else if (mode == MODE_ILS)
+            status = iteratedSearch(&g, submitColoring);
+        else if (mode == MODE_BP)
+            status = propagationSearch(&g, submitColoring);
+        else if (mode == MODE_ML)
+            status = multilevelSearch(&g, submitColoring);
+        else if (mode == MODE_PART) {
+            if (compressGraph(&g) < 0)
+                error_exit("Failed to compress graph");
+            status = partitionedSearch(&g, submitColoring);
+        } else if (mode == MODE_EXACT) {
+            char colors[nodeNum > 0 ? nodeNum : 1];
+            const int COST = exhaustiveSearch(&g, submitColoring, colors);
+            if (COST == -2)
+                error_exit("Graph has too many nodes for exhaustive search");
+            if (COST >= 0)
+                submitOptimum(colors);
+        } else if (mode == MODE_COUNT) {
+            char *count = NULL;
+            if (set.loopN == 0 && countColorings(&g, &count) < 0)
+                error_exit("Failed to allocate counting tables");
+            printf("The graph has %s proper %d-colorings.\n", count != NULL ? count : "0", COLORS);
+            free(count);
+        } else if (mode == MODE_TREE) {
+            char *colors = malloc(nodeNum > 0 ? nodeNum : 1);
+            const int COST = colors != NULL ? treeSearch(&g, submitColoring, colors) : -3;
+            if (COST == -2)
+                error_exit("Graph has too large treewidth for the tree decomposition");
+            if (COST == -3)
+                error_exit("Failed to allocate decomposition tables");
+            if (COST >= 0)
+                submitOptimum(colors);
+            free(colors);
+        } else if (mode == MODE_CSP) {
+            char *colors = malloc(nodeNum > 0 ? nodeNum : 1);
+            const int FOUND = colors != NULL ? decideColoring(&g, submitColoring, colors) : -3;
+            if (FOUND == -2)
+                error_exit("Graph has too many nodes left after peeling for the exact decision");
+            if (FOUND == -3)
+                error_exit("Failed to allocate decision state");
+            if (FOUND == 1)
+                submitOptimum(colors);
+            else if (FOUND == 0)
+                submitBound(set.loopN + 1);
+            free(colors);
+        } else if (mode == MODE_CHROMATIC)
+            status = chromaticSearch(&g, submitBounds);
+        if (status < 0)
+            error_exit("Failed to allocate search state");
+        freeConstruction();
+        freeGraph(&g);
+        freeEdgeSet(&set);
+        free(edges);
+        exit(EXIT_SUCCESS);
+    }
+
+    char nodes[nodeNum];
+    solution_t sol;
+    sol.nodeN = 0;
+    sol.forced = set.loopN;
+    sol.bound = 0;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
     int quit = 0;
 
     while (quit == 0) {
-        int discard = generate3coloring(nodes, NODE_NUM, edges, argc-1, argv, 1, buf);
+        int discard = generateColoring(nodes, nodeNum, sol.edges);
         if (discard != 0)
             continue;
-        
-        if (sem_wait(sem_mutex) == -1)
-            error_exit("sem_wait() failed");
-        if (myshm->state == 0) {
-            if (sem_wait(sem_free) == -1)
-                error_exit("sem_wait() failed");
-            circ_buf_write(buf);
-            if (sem_post(sem_used) == -1)
-                error_exit("sem_wait() failed");
-        } else
-            quit = 1;
-        if (sem_post(sem_mutex) == -1)
-            error_exit("sem_wait() failed");
+        sol.cost = set.loopN;
+        for (int i = 0; i < set.edgeN; i++)
+            sol.cost += nodes[set.edges[i].nodeU] == nodes[set.edges[i].nodeV];
+        quit = writeSolution(&sol);
     }
     
     exit(EXIT_SUCCESS);
@@ -200,7 +529,14 @@ int main(int argc, char **argv) {
 
 
 static void usage(void) {
-    fprintf(stderr, "Usage: %s EDGE1...\n\tEDGE1: U-V, where U and V are vertex numbers\n", myprog);
+    fprintf(stderr, "Usage: %s [-m MODE] [-i INIT] [-k COLORS] EDGE1...\n"
+        "       %s [-m MODE] [-i INIT] [-k COLORS] -f FILE\n"
+        "\tMODE: random (default), weighted, hea, lns, ils, bp, ml, part, stream (requires -f), exact, count, tree,\n"
+        "\t      csp, chromatic\n"
+        "\tINIT: random (default), grasp, prop, spectral\n"
+        "\tCOLORS: 2 to 8, 3 by default, other than 3 only with the modes random, weighted, ils and ml\n"
+        "\tEDGE1: U-V, where U and V are vertex numbers\n"
+        "\tFILE: a file of edges separated by whitespace\n", myprog, myprog);
     exit(EXIT_FAILURE);
 }
 
@@ -255,28 +591,176 @@ static int parseEdges(struct edge *edges, char **str, int n, int offset, char **
     return nodeN;
 }
 
-static int generate3coloring(char *nodes, int nodeN, struct edge *edges, int edgeN, char **edgeStr, int offset, char *buf) {
+static int generateColoring(char *nodes, int nodeN, char *buf) {
+    const struct edge *edges = edgeSet->edges;
+    const int K = getColorCount();
     memset(nodes, 0, nodeN);
     memset(buf, '\0', MAX_LINE);
-    for (int i = 0; i < edgeN; i++) {
+    for (int i = 0; i < edgeSet->loopN; i++) {
+        if (appendEdge(buf, edgeSet->loops[i]) < 0)
+            return -1;
+    }
+    for (int i = 0; i < edgeSet->edgeN; i++) {
         if (nodes[edges[i].nodeU] == 0)
-            nodes[edges[i].nodeU] = (random() % 3) + 1;
+            nodes[edges[i].nodeU] = (random() % K) + 1;
         if (nodes[edges[i].nodeV] == 0)
-            nodes[edges[i].nodeV] = (random() % 3) + 1;
+            nodes[edges[i].nodeV] = (random() % K) + 1;
         
-        if (nodes[edges[i].nodeU] == nodes[edges[i].nodeV]) {
-            if (strlen(buf) > 0) {
-                strncat(buf, " ", MAX_LINE-strlen(buf));
-            }
-            if (MAX_LINE-strlen(buf) < strlen(edgeStr[i+offset])) {
-                return -1;
-            }
-            strncat(buf, edgeStr[i+offset], MAX_LINE-strlen(buf));
-        }
+        if (nodes[edges[i].nodeU] == nodes[edges[i].nodeV] && appendEdge(buf, edgeSet->origin[i]) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int appendEdge(char *buf, int index) {
+    char token[2 * 12];
+    const char *str = token;
+    if (edgeStr != NULL)
+        str = edgeStr[index+edgeOffset];
+    else
+        sprintf(token, "%d-%d", parsed[index].nodeU, parsed[index].nodeV);
+    if (strlen(buf) > 0)
+        strncat(buf, " ", MAX_LINE-strlen(buf));
+    if (MAX_LINE-strlen(buf) < strlen(str))
+        return -1;
+    strncat(buf, str, MAX_LINE-strlen(buf));
+    return 0;
+}
+
+static int formatSolution(const char *colors, char *buf) {
+    memset(buf, '\0', MAX_LINE);
+    for (int i = 0; i < edgeSet->loopN; i++) {
+        if (appendEdge(buf, edgeSet->loops[i]) < 0)
+            return -1;
+    }
+    for (int i = 0; i < graph->edgeN; i++) {
+        if (colors[graph->edges[i].nodeU] == colors[graph->edges[i].nodeV]
+                && appendEdge(buf, edgeSet->origin[i]) < 0)
+            return -1;
     }
     return 0;
 }
 
+static int submitColoring(const char *colors) {
+    solution_t sol;
+    if (colors == NULL || formatSolution(colors, sol.edges) != 0)
+        return __atomic_load_n(&myshm->state, __ATOMIC_RELAXED) != 0;
+    sol.cost = countConflicts(graph, colors) + edgeSet->loopN;
+    sol.forced = edgeSet->loopN;
+    sol.bound = 0;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
+    sol.nodeN = 0;
+    return writeSolution(&sol);
+}
+
+static int submitScored(const char *colors, int conflicts) {
+    solution_t sol;
+    // Every edge takes at least four characters with its separator
+    const int COST = conflicts + edgeSet->loopN;
+    if (colors == NULL || 4 * COST > MAX_LINE || formatSolution(colors, sol.edges) != 0)
+        return __atomic_load_n(&myshm->state, __ATOMIC_RELAXED) != 0;
+    sol.cost = COST;
+    sol.forced = edgeSet->loopN;
+    sol.bound = 0;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
+    sol.nodeN = 0;
+    return writeSolution(&sol);
+}
+
+static int submitRemoved(int cost, const char *edges) {
+    solution_t sol;
+    if (edges == NULL)
+        return __atomic_load_n(&myshm->state, __ATOMIC_RELAXED) != 0;
+    strncpy(sol.edges, edges, MAX_LINE);
+    sol.cost = cost;
+    sol.forced = 0;
+    sol.bound = 0;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
+    sol.nodeN = 0;
+    return writeSolution(&sol);
+}
+
+static int submitOptimum(const char *colors) {
+    solution_t sol;
+    if (formatSolution(colors, sol.edges) != 0)
+        sol.edges[0] = '\0';
+    sol.cost = countConflicts(graph, colors) + edgeSet->loopN;
+    sol.forced = edgeSet->loopN;
+    sol.bound = sol.cost;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
+    sol.nodeN = 0;
+    return writeSolution(&sol);
+}
+
+static int submitBound(int bound) {
+    solution_t sol;
+    sol.edges[0] = '\0';
+    sol.cost = -1;
+    sol.forced = edgeSet->loopN;
+    sol.bound = bound;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
+    sol.nodeN = 0;
+    return writeSolution(&sol);
+}
+
+static int submitBounds(int lower, int upper) {
+    solution_t sol;
+    if (lower == 0 && upper == 0)
+        return __atomic_load_n(&myshm->state, __ATOMIC_RELAXED) != 0;
+    sol.edges[0] = '\0';
+    sol.cost = -1;
+    sol.forced = edgeSet->loopN;
+    sol.bound = 0;
+    sol.colors = getColorCount();
+    sol.lowerColors = lower;
+    sol.upperColors = upper;
+    sol.nodeN = 0;
+    return writeSolution(&sol);
+}
+
+static int submitOffspring(const char *colors) {
+    solution_t sol;
+    if (colors == NULL)
+        return __atomic_load_n(&myshm->state, __ATOMIC_RELAXED) != 0;
+    if (formatSolution(colors, sol.edges) != 0)
+        sol.edges[0] = '\0';
+    sol.cost = countConflicts(graph, colors) + edgeSet->loopN;
+    sol.forced = edgeSet->loopN;
+    sol.bound = 0;
+    sol.colors = getColorCount();
+    sol.lowerColors = 0;
+    sol.upperColors = 0;
+    sol.nodeN = graph->nodeN;
+    memcpy(sol.coloring, colors, graph->nodeN);
+    return writeSolution(&sol);
+}
+
+static int writeSolution(const solution_t *sol) {
+    int quit = 0;
+    if (sem_wait(sem_mutex) == -1)
+        error_exit("sem_wait() failed");
+    if (myshm->state == 0) {
+        if (sem_wait(sem_free) == -1)
+            error_exit("sem_wait() failed");
+        circ_buf_write(sol);
+        if (sem_post(sem_used) == -1)
+            error_exit("sem_wait() failed");
+    } else
+        quit = 1;
+    if (sem_post(sem_mutex) == -1)
+        error_exit("sem_wait() failed");
+    return quit;
+}
 
 static int openSHM(myshm_t **myshm) {
     int shmfd = shm_open(SHM_NAME, O_RDWR, 0600);
@@ -304,8 +788,18 @@ static sem_t * openSEM(const char * sem_name) {
     return sem;
 }
 
-static void circ_buf_write(char *str) {    
-    strncpy(myshm->shm_buf[myshm->write_pos], str, MAX_LINE);
+static void circ_buf_write(const solution_t *sol) {    
+    solution_t *slot = &myshm->shm_buf[myshm->write_pos];
+    slot->cost = sol->cost;
+    slot->forced = sol->forced;
+    slot->bound = sol->bound;
+    slot->colors = sol->colors;
+    slot->lowerColors = sol->lowerColors;
+    slot->upperColors = sol->upperColors;
+    slot->nodeN = sol->nodeN;
+    strncpy(slot->edges, sol->edges, MAX_LINE);
+    if (sol->nodeN > 0)
+        memcpy(slot->coloring, sol->coloring, sol->nodeN);
     myshm->write_pos = (myshm->write_pos + 1) % BUF_LEN;
-    printf("%s [%d]: shm[%d]::%s\n", myprog, getpid(), myshm->write_pos, str);
+    printf("%s [%d]: shm[%d]::%s\n", myprog, getpid(), myshm->write_pos, sol->edges);
 }
\ No newline at end of file
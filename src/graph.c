@@ -0,0 +1,203 @@
+/**
+ * @file graph.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief The graph representation the search engines of the generator operate on.
+ */
+
+#include <string.h>
+#include "graph.h"
+
+#define PACK_PAD    16  /**< The number of bytes after the compressed lists which the group loads may touch. */
+
+// The shuffle table is spelled out at compile time, GAP_BYTE is the source of byte j of lane i under control byte c
+#define GAP_LEN(c, i)       (((c) >> (2 * (i)) & 3) + 1)
+#define GAP_START(c, i)     (((i) > 0 ? GAP_LEN(c, 0) : 0) + ((i) > 1 ? GAP_LEN(c, 1) : 0)                         \
+                            + ((i) > 2 ? GAP_LEN(c, 2) : 0))
+#define GAP_BYTE(c, i, j)   ((j) < GAP_LEN(c, i) ? GAP_START(c, i) + (j) : 16)
+#define GAP_LANE(c, i)      GAP_BYTE(c, i, 0), GAP_BYTE(c, i, 1), GAP_BYTE(c, i, 2), GAP_BYTE(c, i, 3)
+#define GAP_ROW(c)          {GAP_LANE(c, 0), GAP_LANE(c, 1), GAP_LANE(c, 2), GAP_LANE(c, 3)}
+#define GAP_ROWS4(c)        GAP_ROW(c), GAP_ROW((c) + 1), GAP_ROW((c) + 2), GAP_ROW((c) + 3)
+#define GAP_ROWS16(c)       GAP_ROWS4(c), GAP_ROWS4((c) + 4), GAP_ROWS4((c) + 8), GAP_ROWS4((c) + 12)
+#define GAP_ROWS64(c)       GAP_ROWS16(c), GAP_ROWS16((c) + 16), GAP_ROWS16((c) + 32), GAP_ROWS16((c) + 48)
+
+// Global variables
+static int colorN = COLORS;     /**< The selected number of colors. */
+
+const unsigned char groupShuffle[256][16] = {GAP_ROWS64(0), GAP_ROWS64(64), GAP_ROWS64(128), GAP_ROWS64(192)};
+
+/**
+ * @brief Compare two integers for qsort.
+ *
+ * @param a The first integer.
+ * @param b The second integer.
+ * @return Returns a negative number, zero or a positive number if a is less, equal or greater than b.
+ */
+static int compareInt(const void *a, const void *b);
+
+/**
+ * @brief Encode a sorted neighbor list as group varint gaps.
+ *
+ * @details The last group is filled up with zero gaps.
+ *
+ * @param list  The sorted neighbors.
+ * @param n     The number of neighbors.
+ * @param out   The buffer where the encoding should be stored or NULL to only measure it.
+ * @return Returns the number of bytes of the encoding.
+ */
+static size_t encodeList(const int *list, int n, unsigned char *out);
+
+
+int initGraph(graph_t *g, const struct edge *edges, int edgeN, int nodeN) {
+    memset(g, 0, sizeof(*g));
+    g->nodeN = nodeN;
+    g->edgeN = edgeN;
+    g->edges = edges;
+
+    g->offset = calloc(nodeN + 1, sizeof(int));
+    if (g->offset == NULL)
+        return -1;
+
+    for (int i = 0; i < edgeN; i++) {
+        if (edges[i].nodeU == edges[i].nodeV) {
+            g->loopN++;
+            continue;
+        }
+        g->offset[edges[i].nodeU + 1]++;
+        g->offset[edges[i].nodeV + 1]++;
+    }
+    for (int v = 0; v < nodeN; v++)
+        g->offset[v+1] += g->offset[v];
+
+    const int HALF = g->offset[nodeN];
+    g->adj = malloc((HALF > 0 ? HALF : 1) * sizeof(int));
+    g->adjEdge = malloc((HALF > 0 ? HALF : 1) * sizeof(int));
+    int *fill = malloc((nodeN > 0 ? nodeN : 1) * sizeof(int));
+    if (g->adj == NULL || g->adjEdge == NULL || fill == NULL) {
+        free(fill);
+        freeGraph(g);
+        return -1;
+    }
+
+    memcpy(fill, g->offset, nodeN * sizeof(int));
+    for (int i = 0; i < edgeN; i++) {
+        const int U = edges[i].nodeU, V = edges[i].nodeV;
+        if (U == V)
+            continue;
+        g->adj[fill[U]] = V;
+        g->adjEdge[fill[U]++] = i;
+        g->adj[fill[V]] = U;
+        g->adjEdge[fill[V]++] = i;
+    }
+    free(fill);
+
+    return 0;
+}
+
+void freeGraph(graph_t *g) {
+    free(g->offset);
+    free(g->adj);
+    free(g->adjEdge);
+    free(g->packed);
+    free(g->packedOffset);
+    g->offset = NULL;
+    g->adj = NULL;
+    g->adjEdge = NULL;
+    g->packed = NULL;
+    g->packedOffset = NULL;
+}
+
+int compressGraph(graph_t *g) {
+    if (g->adj == NULL)
+        return 0;
+    int maxDeg = 1;
+    for (int v = 0; v < g->nodeN; v++) {
+        if (g->offset[v+1] - g->offset[v] > maxDeg)
+            maxDeg = g->offset[v+1] - g->offset[v];
+    }
+    int *list = malloc(maxDeg * sizeof(int));
+    size_t *at = malloc((g->nodeN + 1) * sizeof(size_t));
+    if (list == NULL || at == NULL) {
+        free(list);
+        free(at);
+        return -1;
+    }
+
+    at[0] = 0;
+    for (int v = 0; v < g->nodeN; v++) {
+        const int DEG = g->offset[v+1] - g->offset[v];
+        memcpy(list, &g->adj[g->offset[v]], DEG * sizeof(int));
+        qsort(list, DEG, sizeof(int), compareInt);
+        at[v+1] = at[v] + encodeList(list, DEG, NULL);
+    }
+    unsigned char *packed = malloc(at[g->nodeN] + PACK_PAD);
+    if (packed == NULL) {
+        free(list);
+        free(at);
+        return -1;
+    }
+    memset(packed + at[g->nodeN], 0, PACK_PAD);
+    for (int v = 0; v < g->nodeN; v++) {
+        const int DEG = g->offset[v+1] - g->offset[v];
+        memcpy(list, &g->adj[g->offset[v]], DEG * sizeof(int));
+        qsort(list, DEG, sizeof(int), compareInt);
+        encodeList(list, DEG, packed + at[v]);
+    }
+
+    free(list);
+    free(g->adj);
+    free(g->adjEdge);
+    g->adj = NULL;
+    g->adjEdge = NULL;
+    g->packed = packed;
+    g->packedOffset = at;
+    return 0;
+}
+
+void setColorCount(int k) {
+    colorN = k;
+}
+
+int getColorCount(void) {
+    return colorN;
+}
+
+int countConflicts(const graph_t *g, const char *colors) {
+    int conflicts = 0;
+    for (int i = 0; i < g->edgeN; i++) {
+        if (colors[g->edges[i].nodeU] == colors[g->edges[i].nodeV])
+            conflicts++;
+    }
+    return conflicts;
+}
+
+
+static int compareInt(const void *a, const void *b) {
+    const int A = *(const int *) a, B = *(const int *) b;
+    return (A > B) - (A < B);
+}
+
+static size_t encodeList(const int *list, int n, unsigned char *out) {
+    size_t len = 0;
+    int last = 0;
+    for (int i = 0; i < n; i += 4) {
+        const size_t CONTROL = len++;
+        unsigned int control = 0;
+        for (int j = 0; j < 4; j++) {
+            const unsigned int GAP = i + j < n ? (unsigned int) (list[i+j] - last) : 0;
+            if (i + j < n)
+                last = list[i+j];
+            const int BYTES = GAP < (1u << 8) ? 1 : GAP < (1u << 16) ? 2 : GAP < (1u << 24) ? 3 : 4;
+            control |= (BYTES - 1) << (2 * j);
+            for (int b = 0; b < BYTES; b++) {
+                if (out != NULL)
+                    out[len] = GAP >> (8 * b);
+                len++;
+            }
+        }
+        if (out != NULL)
+            out[CONTROL] = control;
+    }
+    return len;
+}
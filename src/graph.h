@@ -0,0 +1,194 @@
+/**
+ * @file graph.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief The graph representation the search engines of the generator operate on.
+ *
+ * @details The parsed edge list is turned into a compressed adjacency structure (CSR) so that the neighbors of a
+ * node can be visited without scanning all edges. Self-loops are kept in the edge list but left out of the
+ * adjacency since they conflict under every coloring.
+ *
+ * For very large graphs the adjacency can be compressed: every neighbor list is sorted, the gaps between consecutive
+ * neighbors are stored with group varint encoding (one control byte holding the byte lengths of the next four
+ * values) and the uncompressed arrays are released. Engines which only need the neighbors of a node walk them with a
+ * cursor, which works on both representations and decodes four neighbors at a time: a byte shuffle, looked up by the
+ * control byte, spreads the gaps over four 32 bit lanes, and two shifted additions turn them into a prefix sum. The
+ * shuffle uses the vector extensions of GCC and is only enabled on little endian targets with a byte shuffle
+ * instruction, SSSE3 or NEON, e.g. with make ARCH=native. Without one GCC spells the shuffle out byte by byte, which
+ * is slower than the four masked scalar loads that take over then.
+ */
+
+#pragma once
+#include <stdlib.h>
+#include <string.h>
+
+#define COLORS 3                /**< The default number of colors, to which most engines are fixed. */
+#define MAX_COLORS 8            /**< The maximum number of colors, so that a bitmask of colors fits into a byte. */
+
+#if defined(__GNUC__) && !defined(__clang__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ \
+    && (defined(__SSSE3__) || defined(__ARM_NEON))
+#define GROUP_SHUFFLE           /**< Defined if a compressed group is decoded by a vector shuffle. */
+typedef unsigned char group_bytes_t __attribute__((vector_size(16)));  /**< The bytes of a compressed group. */
+typedef int group_lanes_t __attribute__((vector_size(16)));            /**< The four values of a group. */
+#endif
+
+
+struct edge {   /**< The container for the parsed edge nodes. */
+    int nodeU;  /**< The node value wich is connected to nodeV */
+    int nodeV;  /**< The node value wich is connected to nodeU */
+};
+
+typedef struct graph {          /**< A graph in compressed adjacency form. */
+    int nodeN;                  /**< The number of nodes. */
+    int edgeN;                  /**< The number of edges. */
+    int loopN;                  /**< The number of self-loops. */
+    const struct edge *edges;   /**< The edge list. */
+    int *offset;                /**< The neighbors of node v are adj[offset[v]] till adj[offset[v+1]-1]. */
+    int *adj;                   /**< The neighbor of each half-edge or NULL if the adjacency is compressed. */
+    int *adjEdge;               /**< The edge index of each half-edge or NULL if the adjacency is compressed. */
+    unsigned char *packed;      /**< The compressed neighbor lists or NULL. */
+    size_t *packedOffset;       /**< The compressed neighbors of node v start at packed[packedOffset[v]]. */
+} graph_t;
+
+typedef struct cursor {         /**< The position within the neighbor list of a node. */
+    const int *adj;             /**< The next neighbor of an uncompressed list or NULL. */
+    const unsigned char *data;  /**< The next group of a compressed list. */
+    int left;                   /**< The number of neighbors not returned yet. */
+    int pos;                    /**< The index of the next neighbor in group. */
+    int group[4];               /**< The decoded neighbors of the current group. */
+} cursor_t;
+
+/**
+ * @brief The callback through which a search engine hands colorings to the generator.
+ *
+ * @details The coloring holds one color from 0 to COLORS-1 per node. If colors is NULL nothing is submitted and the
+ * callback only reports whether the engine should stop.
+ *
+ * @param colors    The coloring which should be submitted or NULL.
+ * @return Returns non-zero if the engine should stop.
+ */
+typedef int (*report_fn)(const char *colors);
+
+/**
+ * @brief The shuffle of every control byte, which moves the bytes of the four gaps of a group into four little endian
+ * 32 bit lanes. The index 16 selects a zero byte.
+ */
+extern const unsigned char groupShuffle[256][16];
+
+/**
+ * @brief Build the adjacency structure of a graph.
+ *
+ * @details The edge list is referenced, not copied, and has to outlive the graph.
+ *
+ * @param g         The graph which should be initialized.
+ * @param edges     The edge list.
+ * @param edgeN     The number of edges.
+ * @param nodeN     The number of nodes.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int initGraph(graph_t *g, const struct edge *edges, int edgeN, int nodeN);
+
+/**
+ * @brief Free the adjacency structure of a graph.
+ *
+ * @param g The graph.
+ */
+void freeGraph(graph_t *g);
+
+/**
+ * @brief Compress the adjacency of a graph and release the uncompressed arrays.
+ *
+ * @details Afterwards adj and adjEdge are NULL and the neighbors can only be visited with a cursor. The degrees in
+ * offset stay valid.
+ *
+ * @param g The graph.
+ * @return Returns 0 on success and -1 if memory could not be allocated, in which case the graph is unchanged.
+ */
+int compressGraph(graph_t *g);
+
+/**
+ * @brief Select the number of colors of the engines which support more than COLORS.
+ *
+ * @param k The number of colors from 2 to MAX_COLORS.
+ */
+void setColorCount(int k);
+
+/**
+ * @brief Get the number of colors selected with setColorCount().
+ *
+ * @return Returns the number of colors, COLORS unless another number was selected.
+ */
+int getColorCount(void);
+
+/**
+ * @brief Count the edges whose nodes have the same color.
+ *
+ * @param g         The graph.
+ * @param colors    The coloring.
+ * @return Returns the number of conflicting edges.
+ */
+int countConflicts(const graph_t *g, const char *colors);
+
+/**
+ * @brief Position a cursor at the first neighbor of a node.
+ *
+ * @param c The cursor.
+ * @param g The graph.
+ * @param v The node.
+ */
+static inline void initCursor(cursor_t *c, const graph_t *g, int v) {
+    c->left = g->offset[v+1] - g->offset[v];
+    c->adj = g->adj != NULL ? &g->adj[g->offset[v]] : NULL;
+    c->data = g->packed != NULL ? &g->packed[g->packedOffset[v]] : NULL;
+    c->pos = 4;
+    c->group[3] = 0;
+}
+
+/**
+ * @brief Return the next neighbor of a cursor.
+ *
+ * @details A compressed group is decoded with one 16 byte load, a shuffle and a prefix sum over the lanes, or four
+ * masked 32 bit loads without GROUP_SHUFFLE. The compressed lists are padded so that the loads never leave the
+ * buffer.
+ *
+ * @param c The cursor.
+ * @return Returns the neighbor or -1 if all neighbors were returned.
+ */
+static inline int nextNeighbor(cursor_t *c) {
+    if (c->left == 0)
+        return -1;
+    c->left--;
+    if (c->adj != NULL)
+        return *c->adj++;
+    if (c->pos == 4) {
+        const unsigned int CONTROL = *c->data++;
+#ifdef GROUP_SHUFFLE
+        group_bytes_t bytes, shuffle;
+        memcpy(&bytes, c->data, sizeof(bytes));
+        memcpy(&shuffle, groupShuffle[CONTROL], sizeof(shuffle));
+        group_lanes_t lanes = (group_lanes_t) __builtin_shuffle(bytes, (group_bytes_t) {0}, shuffle);
+        lanes += __builtin_shuffle(lanes, (group_lanes_t) {0}, (group_lanes_t) {4, 0, 1, 2});
+        lanes += __builtin_shuffle(lanes, (group_lanes_t) {0}, (group_lanes_t) {4, 4, 0, 1});
+        lanes += c->group[3];
+        memcpy(c->group, &lanes, sizeof(lanes));
+        c->data += 4 + (CONTROL & 3) + (CONTROL >> 2 & 3) + (CONTROL >> 4 & 3) + (CONTROL >> 6);
+#else
+        static const unsigned int MASK[4] = {0xff, 0xffff, 0xffffff, 0xffffffff};
+        int last = c->group[3];
+        for (int i = 0; i < 4; i++) {
+            unsigned int gap;
+            const int LEN = (CONTROL >> (2 * i)) & 3;
+            memcpy(&gap, c->data, sizeof(gap));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            gap = __builtin_bswap32(gap);
+#endif
+            last += gap & MASK[LEN];
+            c->group[i] = last;
+            c->data += LEN + 1;
+        }
+#endif
+        c->pos = 0;
+    }
+    return c->group[c->pos++];
+}
@@ -0,0 +1,118 @@
+/**
+ * @file hea.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A hybrid evolutionary search which breeds colorings from the elite pool of the supervisor.
+ */
+
+#include "common.h"
+#include "localsearch.h"
+#include "construct.h"
+#include "hea.h"
+
+#define TABU_ITER   10000   /**< The number of tabu search iterations spent on each offspring. */
+
+/**
+ * @brief Copy two distinct random parents out of the elite pool.
+ *
+ * @details Global variables: myshm, sem_pool.
+ *
+ * @param a     The buffer for the first parent.
+ * @param b     The buffer for the second parent.
+ * @param nodeN The number of nodes.
+ * @return Returns 0 on success and -1 if the pool doesn't hold two colorings of this graph yet.
+ */
+static int pickParents(char *a, char *b, int nodeN);
+
+/**
+ * @brief Combine two colorings with the greedy partition crossover (GPX).
+ *
+ * @details The parents take turns in handing down their largest color class, counted over the nodes which are still
+ * unassigned. The nodes left over after COLORS classes get random colors.
+ *
+ * @param a     The first parent.
+ * @param b     The second parent.
+ * @param child The buffer for the child.
+ * @param nodeN The number of nodes.
+ */
+static void crossover(const char *a, const char *b, char *child, int nodeN);
+
+
+int evolutionarySearch(const graph_t *g, report_fn submit) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    search_t s;
+    if (initSearch(&s, g, 0) < 0)
+        return -1;
+    char *a = malloc(N), *b = malloc(N), *child = malloc(N), *best = malloc(N);
+    if (a == NULL || b == NULL || child == NULL || best == NULL) {
+        free(a);
+        free(b);
+        free(child);
+        free(best);
+        freeSearch(&s);
+        return -1;
+    }
+
+    int quit = 0;
+    while (quit == 0) {
+        if (pickParents(a, b, g->nodeN) == 0)
+            crossover(a, b, child, g->nodeN);
+        else
+            initialColoring(g, child);
+
+        loadColoring(&s, child);
+        tabuSearch(&s, TABU_ITER, best);
+        quit = submit(best);
+    }
+
+    free(a);
+    free(b);
+    free(child);
+    free(best);
+    freeSearch(&s);
+    return 0;
+}
+
+
+static int pickParents(char *a, char *b, int nodeN) {
+    const pool_t *pool = &myshm->pool;
+    int status = -1;
+    if (sem_wait(sem_pool) == -1)
+        error_exit("sem_wait() failed");
+    if (pool->size >= 2 && pool->nodeN == nodeN) {
+        const int I = random() % pool->size;
+        const int J = (I + 1 + random() % (pool->size - 1)) % pool->size;
+        memcpy(a, pool->coloring[I], nodeN);
+        memcpy(b, pool->coloring[J], nodeN);
+        status = 0;
+    }
+    if (sem_post(sem_pool) == -1)
+        error_exit("sem_post() failed");
+    return status;
+}
+
+static void crossover(const char *a, const char *b, char *child, int nodeN) {
+    memset(child, COLORS, nodeN);
+    for (int l = 0; l < COLORS; l++) {
+        const char *parent = (l % 2 == 0) ? a : b;
+        int size[COLORS] = {0};
+        for (int v = 0; v < nodeN; v++) {
+            if (child[v] == COLORS)
+                size[(int) parent[v]]++;
+        }
+        int largest = 0;
+        for (int c = 1; c < COLORS; c++) {
+            if (size[c] > size[largest])
+                largest = c;
+        }
+        for (int v = 0; v < nodeN; v++) {
+            if (child[v] == COLORS && parent[v] == largest)
+                child[v] = l;
+        }
+    }
+    for (int v = 0; v < nodeN; v++) {
+        if (child[v] == COLORS)
+            child[v] = random() % COLORS;
+    }
+}
@@ -0,0 +1,27 @@
+/**
+ * @file hea.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A hybrid evolutionary search which breeds colorings from the elite pool of the supervisor.
+ *
+ * @details The supervisor keeps an elite pool of colorings in the shared memory and decides which offspring enter
+ * it. The generators pick two parents from the pool, combine them with the greedy partition crossover (GPX) and
+ * improve the child with a short tabu search before offering it back. Until the pool holds two colorings the
+ * generators offer improved fresh colorings instead.
+ */
+
+#pragma once
+#include "graph.h"
+
+/**
+ * @brief Breed offspring until the callback requests termination.
+ *
+ * @details Every offspring is handed to the callback, which has to attach the coloring for the elite pool.
+ * Global variables: myshm, sem_pool.
+ *
+ * @param g         The graph. It may have at most POOL_NODES nodes.
+ * @param submit    The callback for offering offspring.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int evolutionarySearch(const graph_t *g, report_fn submit);
@@ -0,0 +1,121 @@
+/**
+ * @file ils.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief An iterated local search with adaptive perturbation and Luby restarts.
+ */
+
+#include <string.h>
+#include <limits.h>
+#include "localsearch.h"
+#include "construct.h"
+#include "ils.h"
+
+#define LUBY_UNIT   50000   /**< The number of moves of one unit of the Luby restart schedule. */
+#define LS_ITER     2000    /**< The number of tabu search iterations after each perturbation. */
+#define K_MIN       2       /**< The minimum number of nodes recolored by a perturbation. */
+
+/**
+ * @brief Compute an element of the Luby sequence.
+ *
+ * @param i The index starting from 1.
+ * @return Returns the i-th element of 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ...
+ */
+static long luby(long i);
+
+/**
+ * @brief Recolor k random nodes to a different random color.
+ *
+ * @details Half of the steps swap the colors along a Kempe chain starting at the node instead, as long as the chain
+ * has at most KEMPE_LEN nodes.
+ *
+ * @param s The search state.
+ * @param k The number of nodes.
+ */
+static void perturb(search_t *s, int k);
+
+
+int iteratedSearch(const graph_t *g, report_fn report) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    search_t s;
+    if (initSearch(&s, g, 0) < 0)
+        return -1;
+    char *incumbent = malloc(N), *candidate = malloc(N);
+    if (incumbent == NULL || candidate == NULL) {
+        free(incumbent);
+        free(candidate);
+        freeSearch(&s);
+        return -1;
+    }
+
+    const int K_MAX = g->nodeN / 8 > K_MIN ? g->nodeN / 8 : K_MIN;
+    long best = LONG_MAX;
+    int quit = 0;
+    for (long restart = 1; quit == 0; restart++) {
+        const long START = s.iter, BUDGET = luby(restart) * LUBY_UNIT;
+
+        initialColoring(g, s.colors);
+        loadColoring(&s, s.colors);
+        long cost = tabuSearch(&s, LS_ITER, incumbent);
+        loadColoring(&s, incumbent);
+        int k = K_MIN;
+
+        while (quit == 0 && s.iter - START < BUDGET) {
+            if (cost < best) {
+                best = cost;
+                quit = report(incumbent);
+            } else
+                quit = report(NULL);
+            if (cost == 0 || quit != 0)
+                break;
+
+            perturb(&s, k);
+            const long BEFORE = s.iter;
+            const long NEXT = tabuSearch(&s, LS_ITER, candidate);
+            if (s.iter == BEFORE)
+                s.iter++;
+
+            if (NEXT <= cost) {
+                if (NEXT < cost && k > K_MIN)
+                    k--;
+                cost = NEXT;
+                memcpy(incumbent, candidate, g->nodeN);
+            } else if (k < K_MAX)
+                k++;
+            loadColoring(&s, incumbent);
+        }
+    }
+
+    free(incumbent);
+    free(candidate);
+    freeSearch(&s);
+    return 0;
+}
+
+
+static long luby(long i) {
+    long size = 1, power = 1;
+    while (size < i) {
+        size = 2 * size + 1;
+        power *= 2;
+    }
+    while (size != i) {
+        size = (size - 1) / 2;
+        power /= 2;
+        if (i > size)
+            i -= size;
+    }
+    return power;
+}
+
+static void perturb(search_t *s, int k) {
+    const int N = s->graph->nodeN;
+    for (int i = 0; i < k && N > 0; i++) {
+        const int V = random() % N;
+        const int C = (s->colors[V] + 1 + random() % (s->k - 1)) % s->k;
+        if (random() % 2 == 0 && kempeMove(s, V, C, KEMPE_LEN) >= 0)
+            continue;
+        moveNode(s, V, C);
+    }
+}
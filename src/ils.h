@@ -0,0 +1,27 @@
+/**
+ * @file ils.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief An iterated local search with adaptive perturbation and Luby restarts.
+ *
+ * @details The search alternates a short tabu search with a perturbation of the incumbent coloring. The perturbation
+ * recolors k random nodes or flips Kempe chains starting at them; k grows while perturbed colorings fail to keep up
+ * with the incumbent and shrinks when they improve on it. Independent of progress the search restarts from a fresh
+ * coloring after a budget of moves which follows the Luby sequence (1, 1, 2, 1, 1, 2, 4, ...), which keeps the time
+ * to target robust for heavy-tailed runtimes.
+ */
+
+#pragma once
+#include "graph.h"
+
+/**
+ * @brief Run the iterated local search until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int iteratedSearch(const graph_t *g, report_fn report);
@@ -0,0 +1,208 @@
+/**
+ * @file lns.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A large neighborhood search which re-solves small regions of the graph exactly.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include "localsearch.h"
+#include "construct.h"
+#include "lns.h"
+
+#define REGION_MIN  16      /**< The minimum number of nodes in a region. */
+#define NODE_LIMIT  200000  /**< The number of branch and bound nodes after which a region is given up. */
+#define TABU_ITER   10000   /**< The number of tabu search iterations spent on each start coloring. */
+#define STALL_LIMIT 2000    /**< The number of regions without improvement after which the search restarts. */
+#define POLL_PERIOD 16      /**< The number of regions between two polls of the callback. */
+
+typedef struct region {             /**< A region which is recolored exactly. */
+    int n;                          /**< The number of nodes in the region. */
+    int node[REGION_LEN];           /**< The graph node of each region node. */
+    uint64_t adj[REGION_LEN];       /**< The neighbors of each region node within the region. */
+    int fixed[REGION_LEN][COLORS];  /**< The number of fixed boundary neighbors of each region node per color. */
+    uint64_t cls[COLORS];           /**< The region nodes assigned to each color so far. */
+    char color[REGION_LEN];         /**< The partial coloring of the branch and bound. */
+    char best[REGION_LEN];          /**< The best complete coloring found. */
+    int bestCost;                   /**< The conflicts of the best coloring within and around the region. */
+    long visited;                   /**< The number of branch and bound nodes visited. */
+} region_t;
+
+/**
+ * @brief Grow a region by breadth first search and record its adjacency and boundary colors.
+ *
+ * @details where maps graph nodes to region indices and has to be -1 for all nodes. It is restored before returning.
+ *
+ * @param r         The region.
+ * @param s         The search state holding the current coloring.
+ * @param seed      The node the region grows from.
+ * @param size      The maximum number of nodes in the region.
+ * @param where     The scratch map from graph node to region index.
+ */
+static void buildRegion(region_t *r, const search_t *s, int seed, int size, int *where);
+
+/**
+ * @brief Branch and bound over the colorings of the region nodes from depth on.
+ *
+ * @details The bound adds to the cost so far the cheapest color of every unassigned node against the assigned
+ * nodes and the boundary. Stops once NODE_LIMIT nodes were visited.
+ *
+ * @param r     The region.
+ * @param depth The index of the next region node to color.
+ * @param cost  The conflicts of the partial coloring.
+ */
+static void solveRegion(region_t *r, int depth, int cost);
+
+
+int neighborhoodSearch(const graph_t *g, report_fn report) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    search_t s;
+    if (initSearch(&s, g, 0) < 0)
+        return -1;
+    int *where = malloc(N * sizeof(int));
+    char *start = malloc(N);
+    if (where == NULL || start == NULL) {
+        free(where);
+        free(start);
+        freeSearch(&s);
+        return -1;
+    }
+    for (int v = 0; v < g->nodeN; v++)
+        where[v] = -1;
+
+    region_t r;
+    char old[REGION_LEN];
+    int best = INT_MAX, size = REGION_LEN, quit = 0;
+    long rounds = 0;
+    while (quit == 0) {
+        initialColoring(g, s.colors);
+        loadColoring(&s, s.colors);
+        tabuSearch(&s, TABU_ITER, start);
+        loadColoring(&s, start);
+
+        for (int stall = 0; quit == 0 && stall < STALL_LIMIT; stall++) {
+            if (s.conflicts < best) {
+                best = s.conflicts;
+                stall = 0;
+                quit = report(s.colors);
+            }
+            if (++rounds % POLL_PERIOD == 0 && quit == 0)
+                quit = report(NULL);
+            if (s.confN == 0)
+                break;
+
+            buildRegion(&r, &s, s.confList[random() % s.confN], size, where);
+            memcpy(old, r.best, r.n);
+            memset(r.cls, 0, sizeof(r.cls));
+            r.visited = 0;
+            solveRegion(&r, 0, 0);
+
+            if (r.visited >= NODE_LIMIT && size > REGION_MIN)
+                size--;
+            else if (r.visited < NODE_LIMIT && size < REGION_LEN)
+                size++;
+
+            const int BEFORE = s.conflicts;
+            for (int i = 0; i < r.n; i++)
+                moveNode(&s, r.node[i], r.best[i]);
+            if (s.conflicts > BEFORE) {
+                for (int i = 0; i < r.n; i++)
+                    moveNode(&s, r.node[i], old[i]);
+            }
+        }
+    }
+
+    free(where);
+    free(start);
+    freeSearch(&s);
+    return 0;
+}
+
+
+static void buildRegion(region_t *r, const search_t *s, int seed, int size, int *where) {
+    const graph_t *g = s->graph;
+    r->n = 0;
+    r->node[r->n] = seed;
+    where[seed] = r->n++;
+    for (int head = 0; head < r->n && r->n < size; head++) {
+        const int V = r->node[head];
+        for (int h = g->offset[V]; h < g->offset[V+1] && r->n < size; h++) {
+            const int U = g->adj[h];
+            if (where[U] >= 0)
+                continue;
+            r->node[r->n] = U;
+            where[U] = r->n++;
+        }
+    }
+
+    r->bestCost = 0;
+    memset(r->cls, 0, sizeof(r->cls));
+    for (int i = 0; i < r->n; i++) {
+        const int V = r->node[i];
+        r->adj[i] = 0;
+        memset(r->fixed[i], 0, sizeof(r->fixed[i]));
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+            const int U = g->adj[h];
+            if (where[U] >= 0)
+                r->adj[i] |= (uint64_t) 1 << where[U];
+            else
+                r->fixed[i][(int) s->colors[U]]++;
+        }
+
+        const int C = s->colors[V];
+        r->best[i] = C;
+        r->bestCost += r->fixed[i][C] + __builtin_popcountll(r->adj[i] & r->cls[C]);
+        r->cls[C] |= (uint64_t) 1 << i;
+    }
+
+    for (int i = 0; i < r->n; i++)
+        where[r->node[i]] = -1;
+}
+
+static void solveRegion(region_t *r, int depth, int cost) {
+    if (r->visited++ >= NODE_LIMIT)
+        return;
+    if (depth == r->n) {
+        if (cost < r->bestCost) {
+            r->bestCost = cost;
+            memcpy(r->best, r->color, r->n);
+        }
+        return;
+    }
+
+    int bound = cost;
+    for (int i = depth; i < r->n && bound < r->bestCost; i++) {
+        int cheapest = INT_MAX;
+        for (int c = 0; c < COLORS; c++) {
+            const int INC = r->fixed[i][c] + __builtin_popcountll(r->adj[i] & r->cls[c]);
+            if (INC < cheapest)
+                cheapest = INC;
+        }
+        bound += cheapest;
+    }
+    if (bound >= r->bestCost)
+        return;
+
+    int inc[COLORS], order[COLORS];
+    for (int c = 0; c < COLORS; c++) {
+        inc[c] = r->fixed[depth][c] + __builtin_popcountll(r->adj[depth] & r->cls[c]);
+        int j = c;
+        for (; j > 0 && inc[order[j-1]] > inc[c]; j--)
+            order[j] = order[j-1];
+        order[j] = c;
+    }
+
+    const uint64_t BIT = (uint64_t) 1 << depth;
+    for (int k = 0; k < COLORS; k++) {
+        const int C = order[k];
+        if (cost + inc[C] >= r->bestCost)
+            break;
+        r->cls[C] |= BIT;
+        r->color[depth] = C;
+        solveRegion(r, depth + 1, cost + inc[C]);
+        r->cls[C] &= ~BIT;
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * @file lns.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A large neighborhood search which re-solves small regions of the graph exactly.
+ *
+ * @details Starting from a tabu-improved coloring, the search repeatedly grows a connected region of at most
+ * REGION_LEN nodes around a conflicting node, frees the region and recolors it with an exact branch and bound over
+ * bitsets while the colors of the surrounding nodes stay fixed. The new region coloring is kept if it has less
+ * conflicts. The region grows while the exact search finishes within its node budget and shrinks otherwise.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define REGION_LEN  64  /**< The maximum number of nodes in a region. A region fits into one 64 bit word. */
+
+/**
+ * @brief Run the large neighborhood search until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int neighborhoodSearch(const graph_t *g, report_fn report);
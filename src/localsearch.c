@@ -0,0 +1,324 @@
+/**
+ * @file localsearch.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief The incremental state shared by the local search engines of the generator.
+ */
+
+#include <string.h>
+#include <limits.h>
+#include "localsearch.h"
+
+/**
+ * @brief Add or remove a node from the conflict list depending on its current state.
+ *
+ * @param s The search state.
+ * @param v The node.
+ */
+static void updateConflicting(search_t *s, int v);
+
+/**
+ * @brief Find the best move of a conflicting node for the tabu search.
+ *
+ * @details A move which is tabu is skipped unless it would beat the best cost, and ties are broken uniformly at
+ * random. Dispatches to the scan compiled for the number of colors of the state.
+ *
+ * @param s         The search state.
+ * @param iter      The current iteration.
+ * @param bestCost  The weight of the conflicting edges of the best coloring so far.
+ * @param node      The address where the node should be stored, -1 if every move is tabu.
+ * @param color     The address where the color should be stored.
+ * @return Returns the change in weighted conflicts of the move.
+ */
+static int tabuScan(const search_t *s, long iter, long bestCost, int *node, int *color);
+
+
+int initSearch(search_t *s, const graph_t *g, int weighted) {
+    memset(s, 0, sizeof(*s));
+    s->graph = g;
+    s->k = getColorCount();
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+
+    s->colors = calloc(N, sizeof(char));
+    s->count = calloc((size_t) N * s->k, sizeof(int));
+    s->confList = malloc(N * sizeof(int));
+    s->confPos = malloc(N * sizeof(int));
+    s->tabu = calloc((size_t) N * s->k, sizeof(long));
+    s->visited = calloc(N, sizeof(unsigned int));
+    s->stack = malloc(N * sizeof(int));
+    s->chain = malloc(N * sizeof(int));
+    if (s->colors == NULL || s->count == NULL || s->confList == NULL || s->confPos == NULL || s->tabu == NULL
+            || s->visited == NULL || s->stack == NULL || s->chain == NULL) {
+        freeSearch(s);
+        return -1;
+    }
+
+    s->gamma = s->count;
+    if (weighted) {
+        s->gamma = calloc((size_t) N * s->k, sizeof(int));
+        s->weight = malloc((g->edgeN > 0 ? g->edgeN : 1) * sizeof(int));
+        if (s->gamma == NULL || s->weight == NULL) {
+            freeSearch(s);
+            return -1;
+        }
+        for (int i = 0; i < g->edgeN; i++)
+            s->weight[i] = 1;
+    }
+
+    return 0;
+}
+
+void freeSearch(search_t *s) {
+    if (s->gamma != s->count)
+        free(s->gamma);
+    free(s->count);
+    free(s->colors);
+    free(s->weight);
+    free(s->confList);
+    free(s->confPos);
+    free(s->tabu);
+    free(s->visited);
+    free(s->stack);
+    free(s->chain);
+    memset(s, 0, sizeof(*s));
+}
+
+void randomColoring(char *colors, int nodeN) {
+    for (int v = 0; v < nodeN; v++)
+        colors[v] = random() % getColorCount();
+}
+
+void loadColoring(search_t *s, const char *colors) {
+    const graph_t *g = s->graph;
+    if (colors != s->colors)
+        memcpy(s->colors, colors, g->nodeN);
+
+    memset(s->count, 0, (size_t) g->nodeN * s->k * sizeof(int));
+    if (s->gamma != s->count)
+        memset(s->gamma, 0, (size_t) g->nodeN * s->k * sizeof(int));
+
+    for (int v = 0; v < g->nodeN; v++) {
+        int *cnt = &s->count[v * s->k];
+        for (int h = g->offset[v]; h < g->offset[v+1]; h++)
+            cnt[(int) s->colors[g->adj[h]]]++;
+        if (s->weight != NULL) {
+            int *gam = &s->gamma[v * s->k];
+            for (int h = g->offset[v]; h < g->offset[v+1]; h++)
+                gam[(int) s->colors[g->adj[h]]] += s->weight[g->adjEdge[h]];
+        }
+    }
+
+    s->confN = 0;
+    for (int v = 0; v < g->nodeN; v++) {
+        s->confPos[v] = -1;
+        updateConflicting(s, v);
+    }
+    s->conflicts = countConflicts(g, s->colors);
+    s->cost = s->conflicts;
+    if (s->weight != NULL) {
+        s->cost = 0;
+        for (int i = 0; i < g->edgeN; i++) {
+            if (s->colors[g->edges[i].nodeU] == s->colors[g->edges[i].nodeV])
+                s->cost += s->weight[i];
+        }
+    }
+}
+
+void moveNode(search_t *s, int v, int c) {
+    const graph_t *g = s->graph;
+    const int OLD = s->colors[v];
+    if (OLD == c)
+        return;
+
+    s->conflicts += s->count[v * s->k + c] - s->count[v * s->k + OLD];
+    s->cost += s->gamma[v * s->k + c] - s->gamma[v * s->k + OLD];
+    s->colors[v] = c;
+    for (int h = g->offset[v]; h < g->offset[v+1]; h++) {
+        const int U = g->adj[h];
+        s->count[U * s->k + OLD]--;
+        s->count[U * s->k + c]++;
+        if (s->weight != NULL) {
+            const int W = s->weight[g->adjEdge[h]];
+            s->gamma[U * s->k + OLD] -= W;
+            s->gamma[U * s->k + c] += W;
+        }
+        updateConflicting(s, U);
+    }
+    updateConflicting(s, v);
+}
+
+void addWeight(search_t *s, int e, int delta) {
+    const int U = s->graph->edges[e].nodeU, V = s->graph->edges[e].nodeV;
+    s->weight[e] += delta;
+    if (s->colors[U] == s->colors[V])
+        s->cost += delta;
+    if (U == V)
+        return;
+    s->gamma[U * s->k + s->colors[V]] += delta;
+    s->gamma[V * s->k + s->colors[U]] += delta;
+}
+
+int findBestMove(const search_t *s, int *node, int *color) {
+    int best = INT_MAX, ties = 0;
+    *node = -1;
+    *color = -1;
+
+    for (int i = 0; i < s->confN; i++) {
+        const int V = s->confList[i];
+        const int *gam = &s->gamma[V * s->k];
+        const int CUR = gam[(int) s->colors[V]];
+        for (int c = 0; c < s->k; c++) {
+            if (c == s->colors[V])
+                continue;
+            const int DELTA = gam[c] - CUR;
+            if (DELTA < best) {
+                best = DELTA;
+                ties = 1;
+                *node = V;
+                *color = c;
+            } else if (DELTA == best && random() % ++ties == 0) {
+                *node = V;
+                *color = c;
+            }
+        }
+    }
+    return best;
+}
+
+int kempeMove(search_t *s, int v, int c, int maxLen) {
+    const graph_t *g = s->graph;
+    const int A = s->colors[v];
+    if (A == c)
+        return 0;
+
+    if (++s->epoch == 0) {
+        memset(s->visited, 0, g->nodeN * sizeof(unsigned int));
+        s->epoch = 1;
+    }
+    int top = 0, len = 0;
+    s->visited[v] = s->epoch;
+    s->stack[top++] = v;
+    while (top > 0) {
+        const int U = s->stack[--top];
+        if (len == maxLen)
+            return -1;
+        s->chain[len++] = U;
+        for (int h = g->offset[U]; h < g->offset[U+1]; h++) {
+            const int W = g->adj[h];
+            if (s->visited[W] == s->epoch || (s->colors[W] != A && s->colors[W] != c))
+                continue;
+            s->visited[W] = s->epoch;
+            s->stack[top++] = W;
+        }
+    }
+
+    for (int i = 0; i < len; i++) {
+        const int U = s->chain[i];
+        moveNode(s, U, s->colors[U] == A ? c : A);
+    }
+    return len;
+}
+
+int tryKempeMove(search_t *s, int target) {
+    if (s->confN == 0)
+        return -1;
+    const int V = s->confList[random() % s->confN];
+    const int OLD = s->colors[V];
+    if (kempeMove(s, V, (OLD + 1 + random() % (s->k - 1)) % s->k, KEMPE_LEN) < 0)
+        return -1;
+    if (s->cost < target)
+        return 0;
+    kempeMove(s, V, OLD, KEMPE_LEN);
+    return -1;
+}
+
+long tabuSearch(search_t *s, long maxIter, char *best) {
+    const int N = s->graph->nodeN;
+    long bestCost = s->cost;
+    memcpy(best, s->colors, N);
+
+    for (long i = 0; i < maxIter && s->confN > 0; i++) {
+        const long ITER = ++s->iter;
+        int node, color;
+        const int BEST_DELTA = tabuScan(s, ITER, bestCost, &node, &color);
+        if (node < 0)
+            continue;
+        if (BEST_DELTA >= 0 && tryKempeMove(s, s->cost + BEST_DELTA) == 0) {
+            if (s->cost < bestCost) {
+                bestCost = s->cost;
+                memcpy(best, s->colors, N);
+            }
+            continue;
+        }
+
+        s->tabu[node * s->k + s->colors[node]] = ITER + random() % 10 + (6 * s->conflicts) / 10;
+        moveNode(s, node, color);
+        if (s->cost < bestCost) {
+            bestCost = s->cost;
+            memcpy(best, s->colors, N);
+        }
+    }
+    return bestCost;
+}
+
+
+static void updateConflicting(search_t *s, int v) {
+    const int CONFLICTING = s->count[v * s->k + s->colors[v]] > 0;
+    if (CONFLICTING && s->confPos[v] < 0) {
+        s->confPos[v] = s->confN;
+        s->confList[s->confN++] = v;
+    } else if (!CONFLICTING && s->confPos[v] >= 0) {
+        const int LAST = s->confList[--s->confN];
+        s->confList[s->confPos[v]] = LAST;
+        s->confPos[LAST] = s->confPos[v];
+        s->confPos[v] = -1;
+    }
+}
+
+/**
+ * @brief Define the scan of the tabu search for K colors.
+ *
+ * @param K The number of colors.
+ */
+#define DEFINE_TABU_SCAN(K)                                                                                         \
+static int tabuScan##K(const search_t *s, long iter, long bestCost, int *node, int *color) {                        \
+    int bestDelta = INT_MAX, ties = 0;                                                                              \
+    *node = -1;                                                                                                     \
+    *color = -1;                                                                                                    \
+    for (int j = 0; j < s->confN; j++) {                                                                            \
+        const int V = s->confList[j], CUR_COLOR = s->colors[V];                                                     \
+        const int *GAM = &s->gamma[V * (K)];                                                                        \
+        const long *TABU = &s->tabu[V * (K)];                                                                       \
+        for (int c = 0; c < (K); c++) {                                                                             \
+            const int DELTA = GAM[c] - GAM[CUR_COLOR];                                                              \
+            if (c == CUR_COLOR || (TABU[c] >= iter && s->cost + DELTA >= bestCost))                                 \
+                continue;                                                                                           \
+            if (DELTA < bestDelta) {                                                                                \
+                bestDelta = DELTA;                                                                                  \
+                ties = 1;                                                                                           \
+                *node = V;                                                                                          \
+                *color = c;                                                                                         \
+            } else if (DELTA == bestDelta && random() % ++ties == 0) {                                              \
+                *node = V;                                                                                          \
+                *color = c;                                                                                         \
+            }                                                                                                       \
+        }                                                                                                           \
+    }                                                                                                               \
+    return bestDelta;                                                                                               \
+}
+
+DEFINE_TABU_SCAN(2)
+DEFINE_TABU_SCAN(3)
+DEFINE_TABU_SCAN(4)
+DEFINE_TABU_SCAN(5)
+DEFINE_TABU_SCAN(6)
+DEFINE_TABU_SCAN(7)
+DEFINE_TABU_SCAN(8)
+
+static int tabuScan(const search_t *s, long iter, long bestCost, int *node, int *color) {
+    static int (*const SCAN[MAX_COLORS + 1])(const search_t *, long, long, int *, int *) = {
+        NULL, NULL, tabuScan2, tabuScan3, tabuScan4, tabuScan5, tabuScan6, tabuScan7, tabuScan8
+    };
+    return SCAN[s->k](s, iter, bestCost, node, color);
+}
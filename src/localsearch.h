@@ -0,0 +1,153 @@
+/**
+ * @file localsearch.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief The incremental state shared by the local search engines of the generator.
+ *
+ * @details The state keeps for every node and color the number of neighbors with that color, so that the change in
+ * conflicts of recoloring a node is known in constant time and a move costs only the degree of the moved node. If
+ * the search is weighted a second table holds the summed edge weights instead of plain counts.
+ *
+ * Besides single node moves the state supports Kempe chain interchanges, which swap two colors on a connected
+ * two-colored component. They use a preallocated stack and an epoch-stamped visited array, so a chain costs only its
+ * own size and nothing is allocated or cleared per move.
+ *
+ * The number of colors is selected once with setColorCount(). The scan over the moves of the tabu search is compiled
+ * for every number of colors from 2 to MAX_COLORS, so its loop over the colors has a constant trip count.
+ */
+
+#pragma once
+#include "graph.h"
+
+
+typedef struct search {     /**< The state of a local search over one graph. */
+    const graph_t *graph;   /**< The graph. */
+    int k;                  /**< The number of colors, selected with setColorCount() when the state was allocated. */
+    char *colors;           /**< The current coloring with colors from 0 to k-1. */
+    int *weight;            /**< The weight of each edge or NULL if the search is unweighted. */
+    int *count;             /**< count[v*k+c] is the number of neighbors of v colored c. */
+    int *gamma;             /**< gamma[v*k+c] is the weight of the edges from v to neighbors colored c. */
+    int *confList;          /**< The nodes with at least one conflicting edge. */
+    int *confPos;           /**< The index of each node in confList or -1. */
+    int confN;              /**< The number of nodes in confList. */
+    int conflicts;          /**< The number of conflicting edges. */
+    long cost;              /**< The weight of the conflicting edges. Equals conflicts if the search is unweighted. */
+    long *tabu;             /**< tabu[v*k+c] is the iteration till which moving v to c is tabu. */
+    long iter;              /**< The number of tabu search iterations so far. */
+    unsigned int *visited;  /**< The epoch in which each node was last put on a Kempe chain. */
+    unsigned int epoch;     /**< The epoch of the current Kempe chain. */
+    int *stack;             /**< The explicit stack of the Kempe chain traversal. */
+    int *chain;             /**< The nodes of the current Kempe chain. */
+} search_t;
+
+#define KEMPE_LEN   32      /**< The maximum length of the Kempe chains tried by the local search engines. */
+
+/**
+ * @brief Allocate the state of a local search.
+ *
+ * @details If the search is weighted every edge starts with weight 1, otherwise gamma aliases count.
+ *
+ * @param s         The search state.
+ * @param g         The graph.
+ * @param weighted  Non-zero if the search should track edge weights.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int initSearch(search_t *s, const graph_t *g, int weighted);
+
+/**
+ * @brief Free the state of a local search.
+ *
+ * @param s The search state.
+ */
+void freeSearch(search_t *s);
+
+/**
+ * @brief Assign a uniformly random color out of the selected number of colors to every node.
+ *
+ * @param colors    The coloring.
+ * @param nodeN     The number of nodes.
+ */
+void randomColoring(char *colors, int nodeN);
+
+/**
+ * @brief Load a coloring and rebuild the incremental state from scratch.
+ *
+ * @details The cost is O(V + E). If colors is s->colors the current coloring is only re-evaluated, which is needed
+ * after the edge weights were replaced.
+ *
+ * @param s         The search state.
+ * @param colors    The coloring which should be loaded.
+ */
+void loadColoring(search_t *s, const char *colors);
+
+/**
+ * @brief Recolor a node and update the incremental state.
+ *
+ * @param s     The search state.
+ * @param v     The node.
+ * @param c     The new color.
+ */
+void moveNode(search_t *s, int v, int c);
+
+/**
+ * @brief Add to the weight of an edge and update the weighted table.
+ *
+ * @param s     The weighted search state.
+ * @param e     The edge index.
+ * @param delta The weight which should be added.
+ */
+void addWeight(search_t *s, int e, int delta);
+
+/**
+ * @brief Find the recoloring of a conflicting node which lowers the weighted conflicts the most.
+ *
+ * @details Ties are broken uniformly at random. If no node is conflicting node and color are set to -1.
+ *
+ * @param s     The search state.
+ * @param node  The address where the node should be stored.
+ * @param color The address where the color should be stored.
+ * @return Returns the change in weighted conflicts of the move.
+ */
+int findBestMove(const search_t *s, int *node, int *color);
+
+/**
+ * @brief Swap two colors along a Kempe chain.
+ *
+ * @details The chain is the connected component of v in the subgraph induced by the color of v and c. All its nodes
+ * colored like v get color c and vice versa. If the chain has more than maxLen nodes nothing is changed. Applying
+ * the move again with the old color of v undoes it.
+ *
+ * @param s         The search state.
+ * @param v         The node the chain starts from.
+ * @param c         The color which is swapped with the color of v.
+ * @param maxLen    The maximum number of nodes in the chain.
+ * @return Returns the number of recolored nodes or -1 if the chain was too long.
+ */
+int kempeMove(search_t *s, int v, int c, int maxLen);
+
+/**
+ * @brief Try a Kempe chain from a random conflicting node and keep it if it reaches a cost target.
+ *
+ * @param s         The search state.
+ * @param target    The chain is kept if the weight of the conflicting edges drops below this number.
+ * @return Returns 0 if the chain was kept and -1 otherwise.
+ */
+int tryKempeMove(search_t *s, int target);
+
+/**
+ * @brief Run a tabu search (Tabucol) from the current coloring.
+ *
+ * @details Every iteration performs the best move of a conflicting node which is not tabu, unless it would beat the
+ * best coloring of this call. If no single node move improves, a random Kempe chain of at most KEMPE_LEN nodes is
+ * tried first and kept if it beats the best single node move. A node may not return to its old color for a tenure
+ * proportional to the number of conflicts. The search stops after maxIter iterations or if no node is conflicting. A
+ * weighted search minimizes the weight of the conflicting edges instead of their number.
+ *
+ * @param s         The search state.
+ * @param maxIter   The maximum number of iterations.
+ * @param best      The buffer where the best coloring should be stored.
+ * @return Returns the weight of the conflicting edges of the best coloring, which is their number if the search is
+ * unweighted.
+ */
+long tabuSearch(search_t *s, long maxIter, char *best);
@@ -0,0 +1,267 @@
+/**
+ * @file multilevel.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A multilevel search which solves a coarsened graph and refines the coloring level by level.
+ */
+
+#include <string.h>
+#include <limits.h>
+#include "localsearch.h"
+#include "construct.h"
+#include "multilevel.h"
+
+#define MAX_LEVELS      32      /**< The maximum number of levels including the finest one. */
+#define COARSE_RATIO    0.9     /**< A coarsening step has to shrink the graph below this share of its nodes. */
+#define SCAN_LIMIT      64      /**< The number of neighbors visited per node when looking for a partner. */
+#define LS_ITER         2000    /**< The number of tabu search iterations between two polls of the callback. */
+#define COARSE_ROUNDS   50      /**< The number of tabu searches on the coarsest graph. */
+#define REFINE_ITER     10000   /**< The number of tabu search iterations refining each projected level. */
+#define LS_ROUNDS       50      /**< The number of tabu searches on the finest graph per cycle. */
+
+typedef struct level {      /**< A level of the multilevel hierarchy. */
+    graph_t graph;          /**< The graph of the level. */
+    struct edge *edges;     /**< The edge list of the graph or NULL for the finest level, which borrows it. */
+    int *weight;            /**< The number of finest edges behind each edge or NULL if all are 1. */
+    int *coarse;            /**< The node of the next coarser level each node is merged into. */
+} level_t;
+
+typedef struct scratch {    /**< The buffers of the coarsening, sized for the finest level. */
+    int *order;             /**< The random visiting order, afterwards the first member of each coarse node. */
+    int *mate;              /**< The partner of each node or -1. */
+    int *mark;              /**< The node whose neighborhood was last marked, or the last coarse node seen. */
+    int *score;             /**< The common neighbor weight of each candidate partner, or the slot of a coarse edge. */
+    int *touched;           /**< The candidates with a non-zero score. */
+} scratch_t;
+
+/**
+ * @brief Build the next coarser level by matching nodes with their non-adjacent partners.
+ *
+ * @details Fills fine->coarse. A node is matched with the unmatched node which is reachable over the most edge weight
+ * on paths of length two and not adjacent to it. Parallel coarse edges are merged.
+ *
+ * @param fine      The finer level.
+ * @param coarse    The level which should be built.
+ * @param tmp       The scratch buffers.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int coarsen(level_t *fine, level_t *coarse, scratch_t *tmp);
+
+/**
+ * @brief Free the arrays of a level. The graph of the finest level is not freed.
+ *
+ * @param l The level.
+ */
+static void freeLevel(level_t *l);
+
+/**
+ * @brief Point the search state at a level and load a coloring of it.
+ *
+ * @details The arrays of the state are sized for the finest graph, so it can hold every coarser one.
+ *
+ * @param s         The weighted search state of the finest graph.
+ * @param l         The level.
+ * @param colors    The coloring of the level.
+ */
+static void useLevel(search_t *s, const level_t *l, const char *colors);
+
+
+int multilevelSearch(const graph_t *g, report_fn report) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    level_t level[MAX_LEVELS];
+    scratch_t tmp;
+    search_t s;
+    if (initSearch(&s, g, 1) < 0)
+        return -1;
+    tmp.order = malloc(N * sizeof(int));
+    tmp.mate = malloc(N * sizeof(int));
+    tmp.mark = malloc(N * sizeof(int));
+    tmp.score = calloc(N, sizeof(int));
+    tmp.touched = malloc(N * sizeof(int));
+    char *cur = malloc(N), *next = malloc(N);
+    memset(level, 0, sizeof(level));
+    level[0].graph = *g;
+    int levelN = 1, status = 0;
+    if (tmp.order == NULL || tmp.mate == NULL || tmp.mark == NULL || tmp.score == NULL || tmp.touched == NULL
+            || cur == NULL || next == NULL)
+        status = -1;
+
+    while (status == 0 && levelN < MAX_LEVELS && level[levelN-1].graph.nodeN > COARSE_NODES) {
+        if (coarsen(&level[levelN-1], &level[levelN], &tmp) < 0) {
+            status = -1;
+            break;
+        }
+        if (level[levelN].graph.nodeN > COARSE_RATIO * level[levelN-1].graph.nodeN) {
+            freeLevel(&level[levelN]);
+            break;
+        }
+        levelN++;
+    }
+
+    int record = INT_MAX, quit = status;
+    while (quit == 0) {
+        const level_t *top = &level[levelN-1];
+        initialColoring(&top->graph, cur);
+        useLevel(&s, top, cur);
+        long cost = s.cost;
+        for (int round = 0; quit == 0 && round < COARSE_ROUNDS && cost > 0; round++) {
+            const long NEXT = tabuSearch(&s, LS_ITER, next);
+            if (NEXT < cost) {
+                cost = NEXT;
+                memcpy(cur, next, top->graph.nodeN);
+            }
+            quit = report(NULL);
+        }
+
+        for (int l = levelN - 2; l >= 0 && quit == 0; l--) {
+            for (int v = 0; v < level[l].graph.nodeN; v++)
+                next[v] = cur[level[l].coarse[v]];
+            useLevel(&s, &level[l], next);
+            tabuSearch(&s, REFINE_ITER, cur);
+            quit = report(NULL);
+        }
+        if (quit != 0)
+            break;
+
+        loadColoring(&s, cur);
+        cost = s.cost;
+        for (int round = 0; quit == 0 && round <= LS_ROUNDS; round++) {
+            if (cost < record) {
+                record = cost;
+                quit = report(cur);
+            } else
+                quit = report(NULL);
+            if (cost == 0)
+                break;
+            const long NEXT = tabuSearch(&s, LS_ITER, next);
+            if (NEXT < cost) {
+                cost = NEXT;
+                memcpy(cur, next, g->nodeN);
+            }
+        }
+    }
+
+    for (int l = 0; l < levelN; l++)
+        freeLevel(&level[l]);
+    free(tmp.order);
+    free(tmp.mate);
+    free(tmp.mark);
+    free(tmp.score);
+    free(tmp.touched);
+    free(cur);
+    free(next);
+    freeSearch(&s);
+    return status;
+}
+
+
+static int coarsen(level_t *fine, level_t *coarse, scratch_t *tmp) {
+    const graph_t *g = &fine->graph;
+    const int N = g->nodeN;
+    fine->coarse = malloc((N > 0 ? N : 1) * sizeof(int));
+    if (fine->coarse == NULL)
+        return -1;
+
+    for (int v = 0; v < N; v++) {
+        const int J = random() % (v + 1);
+        tmp->order[v] = tmp->order[J];
+        tmp->order[J] = v;
+        fine->coarse[v] = -1;
+        tmp->mark[v] = -1;
+    }
+
+    int coarseN = 0;
+    for (int i = 0; i < N; i++) {
+        const int V = tmp->order[i];
+        if (fine->coarse[V] >= 0)
+            continue;
+        tmp->mark[V] = V;
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++)
+            tmp->mark[g->adj[h]] = V;
+
+        int touchedN = 0;
+        for (int h = g->offset[V]; h < g->offset[V+1] && h < g->offset[V] + SCAN_LIMIT; h++) {
+            const int U = g->adj[h];
+            const int W1 = fine->weight != NULL ? fine->weight[g->adjEdge[h]] : 1;
+            for (int k = g->offset[U]; k < g->offset[U+1] && k < g->offset[U] + SCAN_LIMIT; k++) {
+                const int X = g->adj[k];
+                const int W2 = fine->weight != NULL ? fine->weight[g->adjEdge[k]] : 1;
+                if (fine->coarse[X] >= 0 || tmp->mark[X] == V)
+                    continue;
+                if (tmp->score[X] == 0)
+                    tmp->touched[touchedN++] = X;
+                tmp->score[X] += W1 < W2 ? W1 : W2;
+            }
+        }
+
+        int mate = -1;
+        for (int j = 0; j < touchedN; j++) {
+            const int X = tmp->touched[j];
+            if (mate < 0 || tmp->score[X] > tmp->score[mate])
+                mate = X;
+            tmp->score[X] = 0;
+        }
+        fine->coarse[V] = coarseN;
+        tmp->mate[V] = mate;
+        if (mate >= 0)
+            fine->coarse[mate] = coarseN;
+        tmp->order[coarseN++] = V;
+    }
+
+    const int HALF = g->offset[N];
+    coarse->edges = malloc((HALF / 2 > 0 ? HALF / 2 : 1) * sizeof(struct edge));
+    coarse->weight = malloc((HALF / 2 > 0 ? HALF / 2 : 1) * sizeof(int));
+    if (coarse->edges == NULL || coarse->weight == NULL) {
+        freeLevel(coarse);
+        return -1;
+    }
+
+    for (int a = 0; a < coarseN; a++)
+        tmp->mark[a] = -1;
+    int edgeN = 0;
+    for (int a = 0; a < coarseN; a++) {
+        const int MEMBER[2] = {tmp->order[a], tmp->mate[tmp->order[a]]};
+        for (int m = 0; m < 2 && MEMBER[m] >= 0; m++) {
+            const int V = MEMBER[m];
+            for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+                const int B = fine->coarse[g->adj[h]];
+                const int W = fine->weight != NULL ? fine->weight[g->adjEdge[h]] : 1;
+                if (B <= a)
+                    continue;
+                if (tmp->mark[B] != a) {
+                    tmp->mark[B] = a;
+                    tmp->score[B] = edgeN;
+                    coarse->edges[edgeN].nodeU = a;
+                    coarse->edges[edgeN].nodeV = B;
+                    coarse->weight[edgeN++] = W;
+                } else
+                    coarse->weight[tmp->score[B]] += W;
+            }
+        }
+    }
+    for (int a = 0; a < coarseN; a++)
+        tmp->score[a] = 0;
+
+    if (initGraph(&coarse->graph, coarse->edges, edgeN, coarseN) < 0) {
+        freeLevel(coarse);
+        return -1;
+    }
+    return 0;
+}
+
+static void freeLevel(level_t *l) {
+    if (l->edges != NULL)
+        freeGraph(&l->graph);
+    free(l->edges);
+    free(l->weight);
+    free(l->coarse);
+    memset(l, 0, sizeof(*l));
+}
+
+static void useLevel(search_t *s, const level_t *l, const char *colors) {
+    s->graph = &l->graph;
+    for (int e = 0; e < l->graph.edgeN; e++)
+        s->weight[e] = l->weight != NULL ? l->weight[e] : 1;
+    loadColoring(s, colors);
+}
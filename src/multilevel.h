@@ -0,0 +1,32 @@
+/**
+ * @file multilevel.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A multilevel search which solves a coarsened graph and refines the coloring level by level.
+ *
+ * @details Every coarsening step matches each node with a non-adjacent partner which shares the most neighbors with
+ * it, the analogue of heavy-edge matching for coloring: nodes with many common neighbors tend to share a color, while
+ * merging adjacent nodes would force a conflict. Matched pairs become one coarse node and parallel coarse edges are
+ * merged into one edge whose weight is their number. Coarsening stops at COARSE_NODES nodes or when a step shrinks
+ * the graph too little. The coarsest graph is solved by weighted tabu search, then the coloring is projected back
+ * level by level and refined by a shorter tabu search at each one. Every level is stored in contiguous arrays, and
+ * the search state and the scratch buffers are sized for the finest level and shared by all of them.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define COARSE_NODES    4096    /**< The number of nodes at which the coarsening stops. */
+
+/**
+ * @brief Run multilevel cycles until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback. The levels
+ * are built once, every cycle starts from a fresh coloring of the coarsest graph.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int multilevelSearch(const graph_t *g, report_fn report);
@@ -0,0 +1,121 @@
+/**
+ * @file normalize.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Turning a parsed edge list into a set of distinct edges without self-loops.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "normalize.h"
+
+#define DIGIT_BITS  16                  /**< The number of key bits sorted per pass. */
+#define BUCKETS     (1 << DIGIT_BITS)   /**< The number of values of a digit. */
+#define PASSES      (64 / DIGIT_BITS)   /**< The number of digits of a key. */
+
+/**
+ * @brief Sort keys together with their indices by an LSD radix sort.
+ *
+ * @details The sorted keys end up in either buffer, so the buffers are swapped accordingly.
+ *
+ * @param key       The address of the keys.
+ * @param index     The address of the indices.
+ * @param keyTmp    The address of a buffer of n keys.
+ * @param indexTmp  The address of a buffer of n indices.
+ * @param n         The number of keys.
+ * @param count     The buffer of PASSES * BUCKETS counters.
+ */
+static void radixSort(uint64_t **key, int **index, uint64_t **keyTmp, int **indexTmp, int n, int *count);
+
+
+int normalizeEdges(const struct edge *edges, int edgeN, edge_set_t *set) {
+    const size_t N = edgeN > 0 ? edgeN : 1;
+    memset(set, 0, sizeof(*set));
+    set->edges = malloc(N * sizeof(struct edge));
+    set->origin = malloc(N * sizeof(int));
+    set->loops = malloc(N * sizeof(int));
+    uint64_t *key = malloc(N * sizeof(uint64_t)), *keyTmp = malloc(N * sizeof(uint64_t));
+    int *index = malloc(N * sizeof(int)), *indexTmp = malloc(N * sizeof(int));
+    int *count = malloc(PASSES * BUCKETS * sizeof(int));
+    int status = 0;
+    if (set->edges == NULL || set->origin == NULL || set->loops == NULL || key == NULL || keyTmp == NULL
+            || index == NULL || indexTmp == NULL || count == NULL) {
+        freeEdgeSet(set);
+        status = -1;
+    }
+
+    if (status == 0) {
+        for (int i = 0; i < edgeN; i++) {
+            const uint64_t U = (unsigned int) edges[i].nodeU, V = (unsigned int) edges[i].nodeV;
+            key[i] = U < V ? U << 32 | V : V << 32 | U;
+            index[i] = i;
+        }
+        radixSort(&key, &index, &keyTmp, &indexTmp, edgeN, count);
+
+        for (int i = 0; i < edgeN; i++) {
+            if (i > 0 && key[i] == key[i-1])
+                continue;
+            const int U = key[i] >> 32, V = key[i] & UINT32_MAX;
+            if (U == V) {
+                set->loops[set->loopN++] = index[i];
+                continue;
+            }
+            set->edges[set->edgeN].nodeU = U;
+            set->edges[set->edgeN].nodeV = V;
+            set->origin[set->edgeN++] = index[i];
+        }
+    }
+
+    free(key);
+    free(keyTmp);
+    free(index);
+    free(indexTmp);
+    free(count);
+    return status;
+}
+
+void freeEdgeSet(edge_set_t *set) {
+    free(set->edges);
+    free(set->origin);
+    free(set->loops);
+    memset(set, 0, sizeof(*set));
+}
+
+
+static void radixSort(uint64_t **key, int **index, uint64_t **keyTmp, int **indexTmp, int n, int *count) {
+    memset(count, 0, PASSES * BUCKETS * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (int p = 0; p < PASSES; p++)
+            count[p * BUCKETS + ((*key)[i] >> (p * DIGIT_BITS) & (BUCKETS - 1))]++;
+    }
+
+    for (int p = 0; p < PASSES && n > 0; p++) {
+        int *bucket = &count[p * BUCKETS];
+        const int SHIFT = p * DIGIT_BITS;
+        if (bucket[(*key)[0] >> SHIFT & (BUCKETS - 1)] == n)
+            continue;
+        for (int d = 0, sum = 0; d < BUCKETS; d++) {
+            const int C = bucket[d];
+            bucket[d] = sum;
+            sum += C;
+        }
+
+        const uint64_t *k = *key;
+        const int *idx = *index;
+        uint64_t *kOut = *keyTmp;
+        int *idxOut = *indexTmp;
+        for (int i = 0; i < n; i++) {
+            const int AT = bucket[k[i] >> SHIFT & (BUCKETS - 1)]++;
+            kOut[AT] = k[i];
+            idxOut[AT] = idx[i];
+        }
+
+        uint64_t *swapKey = *key;
+        *key = *keyTmp;
+        *keyTmp = swapKey;
+        int *swapIndex = *index;
+        *index = *indexTmp;
+        *indexTmp = swapIndex;
+    }
+}
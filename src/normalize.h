@@ -0,0 +1,42 @@
+/**
+ * @file normalize.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief Turning a parsed edge list into a set of distinct edges without self-loops.
+ *
+ * @details Every edge is oriented so that nodeU < nodeV and packed into a 64 bit key with nodeU in the upper half.
+ * The keys are sorted by an LSD radix sort over 16 bit digits. All digit histograms are counted in one pass, and a
+ * digit which is the same for every key, like the upper digits of both halves on graphs with less than 65536 nodes,
+ * skips its scatter pass. The sort is stable, so the first key of each run of duplicates carries the input index of
+ * the first occurrence of the edge, which maps the edge back to its token for the output. Self-loops conflict under
+ * every coloring, so they are kept apart as removals which every solution has to contain.
+ */
+
+#pragma once
+#include "graph.h"
+
+typedef struct edge_set {   /**< A normalized edge list. */
+    struct edge *edges;     /**< The distinct edges without self-loops, oriented nodeU < nodeV and sorted. */
+    int *origin;            /**< The input index of the first occurrence of each edge. */
+    int edgeN;              /**< The number of edges. */
+    int *loops;             /**< The input index of the first occurrence of each distinct self-loop. */
+    int loopN;              /**< The number of distinct self-loops. */
+} edge_set_t;
+
+/**
+ * @brief Orient, sort and deduplicate an edge list and separate its self-loops.
+ *
+ * @param edges The parsed edges.
+ * @param edgeN The number of parsed edges.
+ * @param set   The edge set which should be filled.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int normalizeEdges(const struct edge *edges, int edgeN, edge_set_t *set);
+
+/**
+ * @brief Free the arrays of an edge set.
+ *
+ * @param set   The edge set.
+ */
+void freeEdgeSet(edge_set_t *set);
@@ -0,0 +1,72 @@
+/**
+ * @file parallel.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A parallel loop over an index range for the multithreaded kernels of the generator.
+ */
+
+#include <unistd.h>
+#include <pthread.h>
+#include "parallel.h"
+
+typedef struct chunk {  /**< The chunk of a parallel loop run by one thread. */
+    range_fn fn;        /**< The loop body. */
+    void *arg;          /**< The argument of the loop body. */
+    int from;           /**< The first index. */
+    int to;             /**< The index after the last one. */
+    int thread;         /**< The index of the chunk. */
+} chunk_t;
+
+/**
+ * @brief Run the loop body over one chunk. Runs as a thread.
+ *
+ * @param arg   The chunk_t.
+ * @return Returns NULL.
+ */
+static void *runChunk(void *arg);
+
+
+int parallelThreads(int n, int minChunk) {
+    const long CORES = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = minChunk > 0 ? n / minChunk : n;
+    if (threads > CORES)
+        threads = CORES;
+    if (threads > MAX_THREADS)
+        threads = MAX_THREADS;
+    return threads < 1 ? 1 : threads;
+}
+
+int parallelFor(int n, int minChunk, range_fn fn, void *arg) {
+    const int THREADS = parallelThreads(n, minChunk);
+    pthread_t tid[MAX_THREADS];
+    chunk_t part[MAX_THREADS];
+    int status = 0, started[MAX_THREADS];
+
+    for (int t = 0; t < THREADS; t++) {
+        part[t].fn = fn;
+        part[t].arg = arg;
+        part[t].from = (int) ((long) n * t / THREADS);
+        part[t].to = (int) ((long) n * (t + 1) / THREADS);
+        part[t].thread = t;
+        started[t] = t < THREADS - 1 && pthread_create(&tid[t], NULL, runChunk, &part[t]) == 0;
+        if (t < THREADS - 1 && !started[t])
+            status = -1;
+    }
+    for (int t = 0; t < THREADS; t++) {
+        if (!started[t])
+            runChunk(&part[t]);
+    }
+    for (int t = 0; t < THREADS - 1; t++) {
+        if (started[t])
+            pthread_join(tid[t], NULL);
+    }
+    return status;
+}
+
+
+static void *runChunk(void *arg) {
+    const chunk_t *c = arg;
+    c->fn(c->arg, c->from, c->to, c->thread);
+    return NULL;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file parallel.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A parallel loop over an index range for the multithreaded kernels of the generator.
+ *
+ * @details The range is split into one contiguous chunk per thread. The number of threads is limited by the online
+ * cores, MAX_THREADS and the minimum chunk size, so small ranges run on the calling thread only.
+ */
+
+#pragma once
+
+#define MAX_THREADS 64  /**< The maximum number of threads of a parallel loop. */
+
+/**
+ * @brief The body of a parallel loop.
+ *
+ * @param arg       The argument passed to parallelFor().
+ * @param from      The first index of the chunk.
+ * @param to        The index after the last one of the chunk.
+ * @param thread    The index of the chunk from 0 to MAX_THREADS-1, usable for per-thread results.
+ */
+typedef void (*range_fn)(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Run a loop body over the range 0 to n-1 on multiple threads.
+ *
+ * @details The last chunk runs on the calling thread. Returns after all chunks have finished.
+ *
+ * @param n         The size of the range.
+ * @param minChunk  The minimum number of indices which justify another thread.
+ * @param fn        The loop body.
+ * @param arg       The argument passed to the loop body.
+ * @return Returns 0 on success and -1 if a thread could not be created. The range is fully processed either way.
+ */
+int parallelFor(int n, int minChunk, range_fn fn, void *arg);
+
+/**
+ * @brief Compute the number of threads parallelFor() uses for a range.
+ *
+ * @param n         The size of the range.
+ * @param minChunk  The minimum number of indices which justify another thread.
+ * @return Returns the number of threads.
+ */
+int parallelThreads(int n, int minChunk);
@@ -0,0 +1,347 @@
+/**
+ * @file partition.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A partitioned local search which runs one thread per part of a single large graph.
+ */
+
+#include <string.h>
+#include <limits.h>
+#include "construct.h"
+#include "parallel.h"
+#include "partition.h"
+
+#define NODES_PER_PART  4096    /**< The minimum number of nodes which justify another part. */
+#define BALANCE         1.1     /**< The largest part may hold this multiple of the average part size. */
+#define LABEL_ROUNDS    3       /**< The number of label propagation rounds refining the breadth first parts. */
+#define EPOCH_ITER      2000    /**< The number of tabu search iterations of every part per epoch. */
+#define REPARTITION     16      /**< The number of epochs after which the graph is partitioned anew. */
+
+typedef struct shared {         /**< The state shared by the threads of the partitioned search. */
+    const graph_t *graph;       /**< The graph. */
+    int partN;                  /**< The number of parts. */
+    int *part;                  /**< The part of each node. */
+    int *start;                 /**< The nodes of part p are member[start[p]] till member[start[p+1]-1]. */
+    int *member;                /**< The nodes grouped by part. */
+    char *colors;               /**< The coloring. Each part only writes its own nodes. */
+    char *snapshot;             /**< The coloring at the start of the epoch, from which other parts are read. */
+    char *best;                 /**< The best coloring of each part in the current epoch. */
+    int *count;                 /**< count[v*COLORS+c] is the number of neighbors of v colored c as seen by its part. */
+    long *tabu;                 /**< tabu[v*COLORS+c] is the iteration of the part till which moving v to c is tabu. */
+    int *confList;              /**< The conflicting nodes of part p from confList[start[p]] on. */
+    int *confPos;               /**< The index of each node in confList or -1. */
+    long iter[MAX_THREADS];     /**< The number of tabu search iterations of each part. */
+    unsigned int seed[MAX_THREADS]; /**< The random state of each part. */
+} shared_t;
+
+/**
+ * @brief Split the graph into balanced parts with few edges between them.
+ *
+ * @details Grows the parts by breadth first search from random seeds up to the size cap, puts unreached nodes into
+ * the smallest part and moves nodes to the most frequent part among their neighbors for LABEL_ROUNDS rounds.
+ *
+ * @param st    The shared state.
+ */
+static void partitionGraph(shared_t *st);
+
+/**
+ * @brief Run an epoch of tabu search on a range of parts. Implements range_fn.
+ *
+ * @param arg       The shared_t.
+ * @param from      The first part.
+ * @param to        The part after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void searchParts(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Run an epoch of tabu search on the nodes of one part.
+ *
+ * @details Nodes of other parts keep their snapshot colors. At the end the best coloring of the part is restored.
+ *
+ * @param st    The shared state.
+ * @param p     The part.
+ */
+static void searchPart(shared_t *st, int p);
+
+/**
+ * @brief Move a node of a part to another color and update the counts of its neighbors in the same part.
+ *
+ * @param st    The shared state.
+ * @param p     The part of the node.
+ * @param v     The node.
+ * @param c     The new color.
+ * @param confN The address of the number of conflicting nodes of the part.
+ */
+static void movePartNode(shared_t *st, int p, int v, int c, int *confN);
+
+/**
+ * @brief Add a node of a part to the conflict list of the part or remove it, depending on its current count.
+ *
+ * @param st    The shared state.
+ * @param p     The part of the node.
+ * @param v     The node.
+ * @param confN The address of the number of conflicting nodes of the part.
+ */
+static void updatePartConflicting(shared_t *st, int p, int v, int *confN);
+
+/**
+ * @brief Recolor conflicting nodes on part boundaries to their least conflicting color.
+ *
+ * @param st    The shared state.
+ */
+static void repairBoundary(shared_t *st);
+
+
+int partitionedSearch(const graph_t *g, report_fn report) {
+    const int N = g->nodeN > 0 ? g->nodeN : 1;
+    shared_t st;
+    memset(&st, 0, sizeof(st));
+    st.graph = g;
+    st.partN = parallelThreads(g->nodeN, NODES_PER_PART);
+    st.part = malloc(N * sizeof(int));
+    st.start = malloc((st.partN + 1) * sizeof(int));
+    st.member = malloc(N * sizeof(int));
+    st.colors = malloc(N);
+    st.snapshot = malloc(N);
+    st.best = malloc(N);
+    st.count = malloc((size_t) N * COLORS * sizeof(int));
+    st.tabu = calloc((size_t) N * COLORS, sizeof(long));
+    st.confList = malloc(N * sizeof(int));
+    st.confPos = malloc(N * sizeof(int));
+    int status = 0;
+    if (st.part == NULL || st.start == NULL || st.member == NULL || st.colors == NULL || st.snapshot == NULL
+            || st.best == NULL || st.count == NULL || st.tabu == NULL || st.confList == NULL || st.confPos == NULL)
+        status = -1;
+
+    for (int p = 0; p < st.partN; p++)
+        st.seed[p] = random();
+    int record = INT_MAX, quit = status;
+    if (quit == 0)
+        initialColoring(g, st.colors);
+    for (long epoch = 0; quit == 0; epoch++) {
+        if (epoch % REPARTITION == 0) {
+            partitionGraph(&st);
+            memset(st.tabu, 0, (size_t) g->nodeN * COLORS * sizeof(long));
+            memset(st.iter, 0, sizeof(st.iter));
+        }
+        memcpy(st.snapshot, st.colors, g->nodeN);
+        parallelFor(st.partN, 1, searchParts, &st);
+        repairBoundary(&st);
+
+        const int COST = countConflicts(g, st.colors);
+        if (COST < record) {
+            record = COST;
+            quit = report(st.colors);
+        } else
+            quit = report(NULL);
+    }
+
+    free(st.part);
+    free(st.start);
+    free(st.member);
+    free(st.colors);
+    free(st.snapshot);
+    free(st.best);
+    free(st.count);
+    free(st.tabu);
+    free(st.confList);
+    free(st.confPos);
+    return status;
+}
+
+
+static void partitionGraph(shared_t *st) {
+    const graph_t *g = st->graph;
+    const int N = g->nodeN, P = st->partN;
+    const int CAP = (int) (BALANCE * N / P) + 1;
+    int size[MAX_THREADS], hist[MAX_THREADS], *queue = st->member, head = 0, tail = 0;
+    memset(size, 0, sizeof(size));
+    memset(hist, 0, sizeof(hist));
+    for (int v = 0; v < N; v++)
+        st->part[v] = -1;
+
+    for (int p = 0; p < P && N > 0; p++) {
+        const int V = random() % N;
+        if (st->part[V] >= 0)
+            continue;
+        st->part[V] = p;
+        size[p]++;
+        queue[tail++] = V;
+    }
+    while (head < tail) {
+        const int V = queue[head++], P_V = st->part[V];
+        cursor_t cur;
+        initCursor(&cur, g, V);
+        for (int u; size[P_V] < CAP && (u = nextNeighbor(&cur)) >= 0;) {
+            const int U = u;
+            if (st->part[U] >= 0)
+                continue;
+            st->part[U] = P_V;
+            size[P_V]++;
+            queue[tail++] = U;
+        }
+    }
+    for (int v = 0; v < N; v++) {
+        if (st->part[v] >= 0)
+            continue;
+        int smallest = 0;
+        for (int p = 1; p < P; p++) {
+            if (size[p] < size[smallest])
+                smallest = p;
+        }
+        st->part[v] = smallest;
+        size[smallest]++;
+    }
+
+    for (int round = 0; round < LABEL_ROUNDS && P > 1; round++) {
+        for (int v = 0; v < N; v++) {
+            const int OWN = st->part[v];
+            cursor_t cur;
+            initCursor(&cur, g, v);
+            for (int u; (u = nextNeighbor(&cur)) >= 0;)
+                hist[st->part[u]]++;
+            int target = OWN;
+            for (int q = 0; q < P; q++) {
+                if (hist[q] > hist[target] && size[q] < CAP)
+                    target = q;
+                hist[q] = 0;
+            }
+            if (target != OWN) {
+                st->part[v] = target;
+                size[OWN]--;
+                size[target]++;
+            }
+        }
+    }
+
+    st->start[0] = 0;
+    for (int p = 0; p < P; p++)
+        st->start[p+1] = st->start[p] + size[p];
+    memcpy(size, st->start, P * sizeof(int));
+    for (int v = 0; v < N; v++)
+        st->member[size[st->part[v]]++] = v;
+}
+
+static void searchParts(void *arg, int from, int to, int thread) {
+    for (int p = from; p < to; p++)
+        searchPart(arg, p);
+}
+
+static void searchPart(shared_t *st, int p) {
+    const graph_t *g = st->graph;
+    const int FROM = st->start[p], TO = st->start[p+1];
+    int confN = 0, conflicts = 0;
+    for (int i = FROM; i < TO; i++) {
+        const int V = st->member[i];
+        int *cnt = &st->count[V * COLORS];
+        memset(cnt, 0, COLORS * sizeof(int));
+        cursor_t cur;
+        initCursor(&cur, g, V);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            const int U = u;
+            const int C = st->part[U] == p ? st->colors[U] : st->snapshot[U];
+            cnt[C]++;
+            if (C == st->colors[V] && (st->part[U] != p || U > V))
+                conflicts++;
+        }
+        st->best[V] = st->colors[V];
+        st->confPos[V] = -1;
+    }
+    for (int i = FROM; i < TO; i++)
+        updatePartConflicting(st, p, st->member[i], &confN);
+
+    int bestConflicts = conflicts;
+    for (int it = 0; it < EPOCH_ITER && confN > 0; it++) {
+        const long ITER = ++st->iter[p];
+        int bestDelta = INT_MAX, ties = 0, node = -1, color = -1;
+        for (int j = 0; j < confN; j++) {
+            const int V = st->confList[FROM + j];
+            const int *cnt = &st->count[V * COLORS];
+            for (int c = 0; c < COLORS; c++) {
+                if (c == st->colors[V])
+                    continue;
+                const int DELTA = cnt[c] - cnt[(int) st->colors[V]];
+                if (st->tabu[V * COLORS + c] >= ITER && conflicts + DELTA >= bestConflicts)
+                    continue;
+                if (DELTA < bestDelta) {
+                    bestDelta = DELTA;
+                    ties = 1;
+                    node = V;
+                    color = c;
+                } else if (DELTA == bestDelta && rand_r(&st->seed[p]) % ++ties == 0) {
+                    node = V;
+                    color = c;
+                }
+            }
+        }
+        if (node < 0)
+            continue;
+
+        st->tabu[node * COLORS + st->colors[node]] = ITER + rand_r(&st->seed[p]) % 10 + (6 * conflicts) / 10;
+        conflicts += bestDelta;
+        movePartNode(st, p, node, color, &confN);
+        if (conflicts < bestConflicts) {
+            bestConflicts = conflicts;
+            for (int i = FROM; i < TO; i++)
+                st->best[st->member[i]] = st->colors[st->member[i]];
+        }
+    }
+
+    for (int i = FROM; i < TO; i++)
+        st->colors[st->member[i]] = st->best[st->member[i]];
+}
+
+static void movePartNode(shared_t *st, int p, int v, int c, int *confN) {
+    const graph_t *g = st->graph;
+    const int OLD = st->colors[v];
+    st->colors[v] = c;
+    cursor_t cur;
+    initCursor(&cur, g, v);
+    for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+        const int U = u;
+        if (st->part[U] != p)
+            continue;
+        st->count[U * COLORS + OLD]--;
+        st->count[U * COLORS + c]++;
+        updatePartConflicting(st, p, U, confN);
+    }
+    updatePartConflicting(st, p, v, confN);
+}
+
+static void updatePartConflicting(shared_t *st, int p, int v, int *confN) {
+    const int FROM = st->start[p];
+    const int CONFLICTING = st->count[v * COLORS + st->colors[v]] > 0;
+    if (CONFLICTING && st->confPos[v] < 0) {
+        st->confPos[v] = *confN;
+        st->confList[FROM + (*confN)++] = v;
+    } else if (!CONFLICTING && st->confPos[v] >= 0) {
+        const int LAST = st->confList[FROM + --(*confN)];
+        st->confList[FROM + st->confPos[v]] = LAST;
+        st->confPos[LAST] = st->confPos[v];
+        st->confPos[v] = -1;
+    }
+}
+
+static void repairBoundary(shared_t *st) {
+    const graph_t *g = st->graph;
+    for (int v = 0; v < g->nodeN; v++) {
+        int hist[COLORS] = {0}, boundary = 0;
+        cursor_t cur;
+        initCursor(&cur, g, v);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            hist[(int) st->colors[u]]++;
+            boundary |= st->part[u] != st->part[v];
+        }
+        if (!boundary || hist[(int) st->colors[v]] == 0)
+            continue;
+
+        int color = st->colors[v];
+        for (int c = 0; c < COLORS; c++) {
+            if (hist[c] < hist[color])
+                color = c;
+        }
+        st->colors[v] = color;
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * @file partition.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A partitioned local search which runs one thread per part of a single large graph.
+ *
+ * @details The graph is split into one part per core by a breadth first search from random seeds followed by a few
+ * rounds of size-capped label propagation, which keeps the number of edges between parts small. All threads share
+ * the graph and one coloring array in which every thread only writes the nodes of its own part. The search runs in
+ * epochs: at the start of an epoch the coloring is copied into a snapshot, and during the epoch each thread runs a
+ * tabu search over its own nodes while it reads the colors of nodes in other parts from the snapshot. After all
+ * threads have finished, a sequential pass repairs conflicts between parts that arose from simultaneous moves on
+ * both sides. Every few epochs the graph is partitioned anew, so that conflicts stuck on a boundary move inside a
+ * part. Nothing is duplicated per thread except a few counters.
+ *
+ * The search only visits neighbor lists through cursors, so it runs on a graph whose adjacency was compressed with
+ * compressGraph, which roughly quarters the memory of the adjacency on graphs with small gaps between neighbors.
+ */
+
+#pragma once
+#include "graph.h"
+
+/**
+ * @brief Run the partitioned search until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int partitionedSearch(const graph_t *g, report_fn report);
@@ -0,0 +1,207 @@
+/**
+ * @file spectral.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A spectral construction for planted and nearly colorable graphs.
+ */
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "parallel.h"
+#include "spectral.h"
+
+#define POWER_ITER      500     /**< The maximum number of power iterations. */
+#define POWER_TOL       1e-10   /**< The relative change of the Rayleigh quotients at which the iteration stops. */
+#define KMEANS_ITER     50      /**< The maximum number of k-means iterations. */
+#define ROWS_PER_THREAD 16384   /**< The minimum number of rows which justify another thread. */
+
+typedef struct product {    /**< The operands of the matrix product. */
+    const graph_t *graph;   /**< The graph. */
+    const double *x;        /**< The input block. */
+    double *y;              /**< The output block. */
+    double shift;           /**< The diagonal shift. */
+} product_t;
+
+/**
+ * @brief Multiply a row range of the shifted matrix with a block of EMBED_DIM vectors.
+ *
+ * @details Computes y[v] = shift * x[v] - sum of x[u] over the neighbors u of v. Implements range_fn.
+ *
+ * @param arg       The product_t.
+ * @param from      The first row.
+ * @param to        The row after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void multiplyRows(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Orthonormalize the vectors of a block with Gram-Schmidt.
+ *
+ * @details A vector which vanishes is replaced by a random one.
+ *
+ * @param x     The block.
+ * @param nodeN The number of nodes.
+ */
+static void orthonormalize(double *x, int nodeN);
+
+
+int spectralEmbedding(const graph_t *g, double *embedding) {
+    const int N = g->nodeN;
+    if (N < EMBED_DIM) {
+        memset(embedding, 0, (size_t) N * EMBED_DIM * sizeof(double));
+        return 0;
+    }
+    double *y = malloc(((size_t) N * EMBED_DIM + 1) * sizeof(double));
+    if (y == NULL)
+        return -1;
+
+    double shift = 0;
+    for (int v = 0; v < N; v++) {
+        if (g->offset[v+1] - g->offset[v] > shift)
+            shift = g->offset[v+1] - g->offset[v];
+    }
+
+    for (size_t i = 0; i < (size_t) N * EMBED_DIM; i++)
+        embedding[i] = (double) random() / RAND_MAX - 0.5;
+    orthonormalize(embedding, N);
+
+    double last = 0;
+    for (int it = 0; it < POWER_ITER; it++) {
+        product_t p = {g, embedding, y, shift};
+        parallelFor(N, ROWS_PER_THREAD, multiplyRows, &p);
+
+        double trace = 0;
+        for (size_t i = 0; i < (size_t) N * EMBED_DIM; i++)
+            trace += embedding[i] * y[i];
+        memcpy(embedding, y, (size_t) N * EMBED_DIM * sizeof(double));
+        orthonormalize(embedding, N);
+
+        if (it > 0 && fabs(trace - last) <= POWER_TOL * fabs(trace))
+            break;
+        last = trace;
+    }
+
+    free(y);
+    return 0;
+}
+
+void clusterColoring(const double *embedding, int nodeN, char *colors) {
+    if (nodeN == 0)
+        return;
+
+    double center[COLORS][EMBED_DIM];
+    double *dist = malloc(nodeN * sizeof(double));
+    const double *first = &embedding[(random() % nodeN) * EMBED_DIM];
+    memcpy(center[0], first, sizeof(center[0]));
+    for (int k = 1; k < COLORS; k++) {
+        double total = 0;
+        for (int v = 0; v < nodeN; v++) {
+            double nearest = DBL_MAX;
+            for (int j = 0; j < k; j++) {
+                double d = 0;
+                for (int i = 0; i < EMBED_DIM; i++) {
+                    const double DIFF = embedding[v * EMBED_DIM + i] - center[j][i];
+                    d += DIFF * DIFF;
+                }
+                if (d < nearest)
+                    nearest = d;
+            }
+            if (dist != NULL)
+                dist[v] = nearest;
+            total += nearest;
+        }
+
+        int pick = random() % nodeN;
+        if (dist != NULL && total > 0) {
+            double r = (double) random() / RAND_MAX * total;
+            for (pick = 0; pick < nodeN - 1 && r > dist[pick]; pick++)
+                r -= dist[pick];
+        }
+        memcpy(center[k], &embedding[pick * EMBED_DIM], sizeof(center[k]));
+    }
+    free(dist);
+
+    memset(colors, COLORS, nodeN);
+    for (int it = 0, changed = 1; it < KMEANS_ITER && changed; it++) {
+        changed = 0;
+        double sum[COLORS][EMBED_DIM];
+        int size[COLORS];
+        memset(sum, 0, sizeof(sum));
+        memset(size, 0, sizeof(size));
+
+        for (int v = 0; v < nodeN; v++) {
+            int nearest = 0;
+            double best = DBL_MAX;
+            for (int k = 0; k < COLORS; k++) {
+                double d = 0;
+                for (int i = 0; i < EMBED_DIM; i++) {
+                    const double DIFF = embedding[v * EMBED_DIM + i] - center[k][i];
+                    d += DIFF * DIFF;
+                }
+                if (d < best) {
+                    best = d;
+                    nearest = k;
+                }
+            }
+            if (colors[v] != nearest) {
+                colors[v] = nearest;
+                changed = 1;
+            }
+            size[nearest]++;
+            for (int i = 0; i < EMBED_DIM; i++)
+                sum[nearest][i] += embedding[v * EMBED_DIM + i];
+        }
+
+        for (int k = 0; k < COLORS; k++) {
+            for (int i = 0; i < EMBED_DIM && size[k] > 0; i++)
+                center[k][i] = sum[k][i] / size[k];
+        }
+    }
+}
+
+
+static void multiplyRows(void *arg, int from, int to, int thread) {
+    const product_t *p = arg;
+    const graph_t *g = p->graph;
+    for (int v = from; v < to; v++) {
+        double acc[EMBED_DIM];
+        for (int i = 0; i < EMBED_DIM; i++)
+            acc[i] = p->shift * p->x[v * EMBED_DIM + i];
+        cursor_t cur;
+        initCursor(&cur, g, v);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            const double *xu = &p->x[u * EMBED_DIM];
+            for (int i = 0; i < EMBED_DIM; i++)
+                acc[i] -= xu[i];
+        }
+        for (int i = 0; i < EMBED_DIM; i++)
+            p->y[v * EMBED_DIM + i] = acc[i];
+    }
+}
+
+static void orthonormalize(double *x, int nodeN) {
+    for (int i = 0; i < EMBED_DIM; i++) {
+        for (int j = 0; j < i; j++) {
+            double dot = 0;
+            for (int v = 0; v < nodeN; v++)
+                dot += x[v * EMBED_DIM + i] * x[v * EMBED_DIM + j];
+            for (int v = 0; v < nodeN; v++)
+                x[v * EMBED_DIM + i] -= dot * x[v * EMBED_DIM + j];
+        }
+
+        double norm = 0;
+        for (int v = 0; v < nodeN; v++)
+            norm += x[v * EMBED_DIM + i] * x[v * EMBED_DIM + i];
+        norm = sqrt(norm);
+        if (norm < 1e-300) {
+            for (int v = 0; v < nodeN; v++)
+                x[v * EMBED_DIM + i] = (double) random() / RAND_MAX - 0.5;
+            i--;
+            continue;
+        }
+        for (int v = 0; v < nodeN; v++)
+            x[v * EMBED_DIM + i] /= norm;
+    }
+}
@@ -0,0 +1,40 @@
+/**
+ * @file spectral.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A spectral construction for planted and nearly colorable graphs.
+ *
+ * @details The eigenvectors of the two most negative eigenvalues of the adjacency matrix separate the color classes
+ * of a planted 3-coloring. They are computed by blocked power iteration on the shifted matrix maxDegree * I - A,
+ * whose largest eigenvalues are the most negative ones of A. The sparse matrix product runs over the CSR graph and
+ * is split into row ranges across threads. Every node is then a point in the plane spanned by the two vectors, and
+ * k-means clustering with COLORS centers turns the points into a coloring.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define EMBED_DIM   2   /**< The number of eigenvectors in the embedding. */
+
+/**
+ * @brief Compute the spectral embedding of a graph.
+ *
+ * @details The embedding holds EMBED_DIM coordinates per node, stored node by node.
+ *
+ * @param g         The graph.
+ * @param embedding The buffer of nodeN * EMBED_DIM coordinates.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int spectralEmbedding(const graph_t *g, double *embedding);
+
+/**
+ * @brief Cluster the embedded nodes into COLORS classes.
+ *
+ * @details Runs Lloyd's k-means from a k-means++ seeding, so repeated calls yield different colorings.
+ *
+ * @param embedding The spectral embedding.
+ * @param nodeN     The number of nodes.
+ * @param colors    The buffer where the coloring should be stored.
+ */
+void clusterColoring(const double *embedding, int nodeN, char *colors);
@@ -0,0 +1,179 @@
+/**
+ * @file stream.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A semi-streaming search for edge files which don't fit into memory as an edge array.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "common.h"
+#include "edgefile.h"
+#include "stream.h"
+
+#define MOVE_ODDS       2   /**< An improving move is applied with probability 1 / MOVE_ODDS. */
+#define SIDEWAYS_ODDS   8   /**< A move to an equally bad color is applied with probability 1 / SIDEWAYS_ODDS. */
+#define NOISE_ODDS      64  /**< A worsening move of a conflicting node is applied with probability 1 / NOISE_ODDS. */
+
+typedef struct pass {       /**< The state of the semi-streaming search. */
+    unsigned char *packed;  /**< The coloring with four nodes per byte. */
+    unsigned int *count;    /**< count[v*COLORS+c] is the number of neighbors of v colored c in the last pass. */
+    int conflicts;          /**< The number of conflicting edges in the last pass. */
+    int length;             /**< The length of the conflicting edge list or -1 if it didn't fit. */
+    char removed[MAX_LINE]; /**< The conflicting edges of the last pass. */
+} pass_t;
+
+/**
+ * @brief Read the color of a node from the packed coloring.
+ *
+ * @param packed    The packed coloring.
+ * @param v         The node.
+ * @return Returns the color.
+ */
+static int getColor(const unsigned char *packed, int v);
+
+/**
+ * @brief Write the color of a node into the packed coloring.
+ *
+ * @param packed    The packed coloring.
+ * @param v         The node.
+ * @param c         The color.
+ */
+static void setColor(unsigned char *packed, int v, int c);
+
+/**
+ * @brief Accept a batch of edges without looking at it. Implements edges_fn.
+ *
+ * @param arg   Unused.
+ * @param batch The edges.
+ * @param n     The number of edges.
+ * @return Returns 0.
+ */
+static int skipEdges(void *arg, const struct edge *batch, int n);
+
+/**
+ * @brief Count the conflicts of a batch of edges and gather the neighbor color counts. Implements edges_fn.
+ *
+ * @param arg   The pass_t.
+ * @param batch The edges.
+ * @param n     The number of edges.
+ * @return Returns 0.
+ */
+static int countEdges(void *arg, const struct edge *batch, int n);
+
+/**
+ * @brief Move the conflicting nodes to their least conflicting colors according to the gathered counts.
+ *
+ * @param p     The search state.
+ * @param nodeN The number of nodes.
+ */
+static void recolor(pass_t *p, int nodeN);
+
+
+int streamingSearch(const char *path, removed_fn report, long *line) {
+    const int NODE_N = scanEdgeFile(path, skipEdges, NULL, line);
+    if (NODE_N < 0)
+        return NODE_N;
+
+    pass_t p;
+    p.packed = malloc(NODE_N / 4 + 1);
+    p.count = malloc(((size_t) NODE_N * COLORS + 1) * sizeof(unsigned int));
+    if (p.packed == NULL || p.count == NULL) {
+        free(p.packed);
+        free(p.count);
+        return -1;
+    }
+    for (int v = 0; v < NODE_N; v++)
+        setColor(p.packed, v, random() % COLORS);
+
+    int record = INT_MAX, quit = 0, status = 0;
+    while (quit == 0) {
+        memset(p.count, 0, (size_t) NODE_N * COLORS * sizeof(unsigned int));
+        p.conflicts = 0;
+        p.length = 0;
+        p.removed[0] = '\0';
+        status = scanEdgeFile(path, countEdges, &p, line);
+        if (status < 0)
+            break;
+        status = 0;
+
+        if (p.conflicts < record && p.length >= 0) {
+            record = p.conflicts;
+            quit = report(p.conflicts, p.removed);
+        } else
+            quit = report(p.conflicts, NULL);
+        recolor(&p, NODE_N);
+    }
+
+    free(p.packed);
+    free(p.count);
+    return status;
+}
+
+
+static int getColor(const unsigned char *packed, int v) {
+    return (packed[v >> 2] >> ((v & 3) << 1)) & 3;
+}
+
+static void setColor(unsigned char *packed, int v, int c) {
+    const int SHIFT = (v & 3) << 1;
+    packed[v >> 2] = (packed[v >> 2] & ~(3 << SHIFT)) | (c << SHIFT);
+}
+
+static int skipEdges(void *arg, const struct edge *batch, int n) {
+    return 0;
+}
+
+static int countEdges(void *arg, const struct edge *batch, int n) {
+    pass_t *p = arg;
+    for (int i = 0; i < n; i++) {
+        const int U = batch[i].nodeU, V = batch[i].nodeV;
+        const int CU = getColor(p->packed, U), CV = getColor(p->packed, V);
+        if (U != V) {
+            p->count[U * COLORS + CV]++;
+            p->count[V * COLORS + CU]++;
+        }
+        if (CU != CV)
+            continue;
+
+        p->conflicts++;
+        if (p->length < 0)
+            continue;
+        char token[2 * 12];
+        const int LEN = sprintf(token, "%s%d-%d", p->length > 0 ? " " : "", U, V);
+        if (p->length + LEN >= MAX_LINE) {
+            p->length = -1;
+            continue;
+        }
+        memcpy(p->removed + p->length, token, LEN + 1);
+        p->length += LEN;
+    }
+    return 0;
+}
+
+static void recolor(pass_t *p, int nodeN) {
+    for (int v = 0; v < nodeN; v++) {
+        const unsigned int *cnt = &p->count[(size_t) v * COLORS];
+        const int CUR = getColor(p->packed, v);
+        if (cnt[CUR] == 0)
+            continue;
+
+        int best = CUR, ties = 0;
+        for (int c = 0; c < COLORS; c++) {
+            if (c == CUR)
+                continue;
+            if (cnt[c] < cnt[best] || (best == CUR && cnt[c] == cnt[CUR])) {
+                best = c;
+                ties = 1;
+            } else if (cnt[c] == cnt[best] && random() % ++ties == 0)
+                best = c;
+        }
+        if (best == CUR)
+            best = (CUR + 1 + random() % (COLORS - 1)) % COLORS;
+        const int ODDS = cnt[best] < cnt[CUR] ? MOVE_ODDS : cnt[best] == cnt[CUR] ? SIDEWAYS_ODDS : NOISE_ODDS;
+        if (random() % ODDS == 0)
+            setColor(p->packed, v, best);
+    }
+}
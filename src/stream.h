@@ -0,0 +1,39 @@
+/**
+ * @file stream.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A semi-streaming search for edge files which don't fit into memory as an edge array.
+ *
+ * @details The search keeps only O(V) state: the coloring packed into two bits per node and, for every node and
+ * color, the number of neighbors with that color. Each pass streams the edge file (see edgefile.h) once, counts the
+ * conflicting edges of the current coloring and gathers the neighbor color counts. Between two passes every
+ * conflicting node moves to its least conflicting color according to those counts. A move is only applied with some
+ * probability, so that the two ends of a conflicting edge rarely flip together, and ties are taken occasionally to
+ * leave plateaus.
+ */
+
+#pragma once
+
+/**
+ * @brief The callback through which the semi-streaming search hands solutions to the generator.
+ *
+ * @param cost  The number of conflicting edges.
+ * @param edges The conflicting edges as they are written to the circular buffer, or NULL to only poll.
+ * @return Returns non-zero if the search should stop.
+ */
+typedef int (*removed_fn)(int cost, const char *edges);
+
+/**
+ * @brief Run streaming passes over an edge file until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback if its
+ * conflicting edges fit into a solution.
+ *
+ * @param path      The path of the edge file.
+ * @param report    The callback for submitting solutions.
+ * @param line      The address where the line number of a parse error should be stored.
+ * @return Returns 0 on success, -1 if the file could not be read or memory could not be allocated and -2 on a
+ * parse error.
+ */
+int streamingSearch(const char *path, removed_fn report, long *line);
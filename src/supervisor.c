@@ -5,11 +5,13 @@
  *
  * @brief Print the solution with the lowest amount of removed edges so that the graph is 3-colorable.
  * 
- * @details Set up the shared memory and the semaphores and initialize the circular buffer for communication 
- * with the generators. Wait for the generators to write solutions to the circular buffer. Remeber the solution 
- * with the least edges and print it to stdout. If a solution with 0 edges is read or SIGINT or SIGTERM is caught 
- * terminate the program. Before terminating notify all generators that they should terminate. Unlink all shared 
- * resources and terminate.
+ * @details Set up the shared memory and the semaphores and initialize the circular buffer for communication with 
+ * the generators. Wait for the generators to write solutions to the circular buffer. Remeber the solution with the 
+ * least edges and print it to stdout. Generators may also send proven lower bounds on the removed edges, or bounds 
+ * on the chromatic number, which are printed as they tighten and terminate the program once they meet. If a 
+ * solution with 0 edges, with no edges besides the self-loops every solution has to remove or with as few edges as 
+ * the best bound is read or SIGINT or SIGTERM is caught terminate the program. Before terminating notify all 
+ * generators that they should terminate. Unlink all shared resources and terminate.
  */
 #define _GNU_SOURCE
 #include <stdio.h>
@@ -19,8 +21,11 @@
 #include <string.h>
 #include <limits.h>
 #include "common.h"
+#include "graph.h"
 
 
+#define DIVERSITY   20  /**< A coloring closer than nodeN/DIVERSITY to a pool member counts as its duplicate. */
+
 // Global variables
 volatile __sig_atomic_t quit = 0;   /**< The quit flag if SIGINT or SIGTERM is triggered */
 
@@ -87,23 +92,46 @@ static void cleanupSemFree(void);
 static void cleanupSemMutex(void);
 
 /**
- * @brief Read a string from the circular buffer in the shared memory.
+ * @brief Close and unlink the '/3col_pool' semaphore.
+ */
+static void cleanupSemPool(void);
+
+/**
+ * @brief Read a solution from the circular buffer in the shared memory.
  * 
- * @details Read a string from the circular buffer at read_pos and store it in buf. 
+ * @details Read a solution from the circular buffer at read_pos and store it in sol. The coloring is only copied if 
+ * one is attached.
  * Global variables: myshm.
  * 
- * @param buf       The buffer where the read value should be stored.
+ * @param sol       The solution where the read value should be stored.
  * @param read_pos  The index of the circular buffer from where the value should be read.
  */
-static void circ_buf_read(char *buf, int *read_pos);
+static void circ_buf_read(solution_t *sol, int *read_pos);
 
 /**
- * @brief Count the number of edges.
+ * @brief Compute the distance between two colorings.
+ * 
+ * @details The distance is the number of nodes which have to be recolored to turn one partition into the other. The 
+ * color classes are matched greedily by their overlap, so renamed colors don't count.
  * 
- * @param edges The string representing the edges.
- * @return Returns the edge count.
+ * @param a     The first coloring.
+ * @param b     The second coloring.
+ * @param nodeN The number of nodes.
+ * @return Returns the distance.
  */
-static uint countEdges(char *edges);
+static int colorDistance(const char *a, const char *b, int nodeN);
+
+/**
+ * @brief Offer a coloring to the elite pool.
+ * 
+ * @details The pool keeps its members apart: a coloring which is within nodeN/DIVERSITY of a member only replaces 
+ * that member and only if it is better. Otherwise it fills a free slot or replaces the worst member if it is not 
+ * worse. Colorings of a different size than the pooled ones are ignored.
+ * Global variables: myshm, sem_pool.
+ * 
+ * @param sol   The solution with the attached coloring.
+ */
+static void poolInsert(const solution_t *sol);
 
 
 /**
@@ -148,6 +176,10 @@ int main(int argc, char **argv) {
     if (atexit(cleanupSemMutex) != 0)
         error_exit("atexit() failed");
 
+    sem_pool = initSEM(SEM_POOL, 1);
+    if (atexit(cleanupSemPool) != 0)
+        error_exit("atexit() failed");
+
 
     if (sem_wait(sem_mutex) == -1) {
         if (errno != EINTR)
@@ -155,6 +187,10 @@ int main(int argc, char **argv) {
     }
     myshm->state = 0;
     myshm->write_pos = 0;
+    myshm->weight_bumps = 0;
+    memset(myshm->weight, 0, sizeof(myshm->weight));
+    myshm->pool.size = 0;
+    myshm->pool.nodeN = 0;
     if (sem_post(sem_mutex) == -1) {
         if (errno != EINTR)
             error_exit("sem_wait() failed");
@@ -162,10 +198,9 @@ int main(int argc, char **argv) {
 
 
     int read_pos = 0;
-    uint bestSolution = UINT_MAX;
-    char edges[MAX_LINE];
+    uint bestSolution = UINT_MAX, lowerBound = 0, lowerColors = 0, upperColors = UINT_MAX;
+    solution_t sol;
     while (!quit) {
-        memset(edges, '\0', sizeof(edges));
 
         /* Critical section start */
         if (sem_wait(sem_used) == -1) {
@@ -173,7 +208,7 @@ int main(int argc, char **argv) {
                 error_exit("sem_wait() failed");
             quit = 1;
         }
-        circ_buf_read(edges, &read_pos);
+        circ_buf_read(&sol, &read_pos);
         if (sem_post(sem_free) == -1) {
             if (errno != EINTR)
                 error_exit("sem_post() failed");
@@ -183,13 +218,51 @@ int main(int argc, char **argv) {
         if (quit != 0)
             break;
 
-        uint edgeCount = countEdges(edges);
-        if (edgeCount > 0 && edgeCount < bestSolution) {
-            bestSolution = edgeCount;
-            printf("Solution with %d edges: %s\n", edgeCount, edges);
-        } else if (edgeCount == 0) {
+        if (sol.nodeN > 0)
+            poolInsert(&sol);
+        if (sol.lowerColors > 0 || sol.upperColors > 0) {
+            if ((uint) sol.lowerColors > lowerColors) {
+                lowerColors = sol.lowerColors;
+                printf("The chromatic number is at least %u.\n", lowerColors);
+            }
+            if (sol.upperColors > 0 && (uint) sol.upperColors < upperColors) {
+                upperColors = sol.upperColors;
+                printf("The chromatic number is at most %u.\n", upperColors);
+            }
+            if (lowerColors == upperColors) {
+                myshm->state = 1;
+                printf("The chromatic number is %u%s!\n", lowerColors, sol.forced > 0 ? " without the self-loops" : "");
+                break;
+            }
+            continue;
+        }
+        if ((uint) sol.bound > lowerBound) {
+            lowerBound = sol.bound;
+            if (sol.cost < 0 && sol.forced > 0)
+                printf("The graph is not %d-colorable without its self-loops!\n", sol.colors);
+            else if (sol.cost < 0)
+                printf("The graph is not %d-colorable!\n", sol.colors);
+        }
+        // A solution whose edges didn't fit only counts if it is proven to be optimal
+        if (sol.cost >= 0 && (uint) sol.cost < bestSolution && (sol.edges[0] != '\0' || sol.cost == sol.bound)) {
+            bestSolution = sol.cost;
+            if (sol.cost > 0 && sol.edges[0] != '\0')
+                printf("Solution with %d edges: %s\n", sol.cost, sol.edges);
+        }
+
+        if (bestSolution == 0) {
             myshm->state = 1;
-            printf("The graph is 3-colorable!\n");
+            printf("The graph is %d-colorable!\n", sol.colors);
+            break;
+        }
+        if (bestSolution == (uint) sol.forced) {
+            myshm->state = 1;
+            printf("The graph is %d-colorable without its self-loops!\n", sol.colors);
+            break;
+        }
+        if (bestSolution <= lowerBound) {
+            myshm->state = 1;
+            printf("No solution removes less than %u edges!\n", bestSolution);
             break;
         }
     }
@@ -265,22 +338,94 @@ static void cleanupSemMutex(void) {
         print_error("Failed to unlink /01528992_3col_mutex");
 }
 
-static uint countEdges(char *edges) {
-    if (strlen(edges) == 0)
-        return 0;
-
-    uint count = 0;
-    char *ws = edges;
-    while (ws != NULL) {
-        count++;
-        if (*ws == ' ')
-            ws++;
-        ws = strchr(ws, ' ');
-    }
-    return count;
+static void cleanupSemPool(void) {
+    closeSemPool();
+    if (sem_unlink(SEM_POOL) == -1)
+        print_error("Failed to unlink " SEM_POOL);
 }
 
-static void circ_buf_read(char *buf, int *read_pos) {
-    snprintf(buf, MAX_LINE, "%s", myshm->shm_buf[*read_pos]);
+static void circ_buf_read(solution_t *sol, int *read_pos) {
+    const solution_t *slot = &myshm->shm_buf[*read_pos];
+    sol->cost = slot->cost;
+    sol->forced = slot->forced;
+    sol->bound = slot->bound;
+    sol->colors = slot->colors;
+    sol->lowerColors = slot->lowerColors;
+    sol->upperColors = slot->upperColors;
+    sol->nodeN = slot->nodeN;
+    snprintf(sol->edges, MAX_LINE, "%s", slot->edges);
+    if (sol->nodeN > 0 && sol->nodeN <= POOL_NODES)
+        memcpy(sol->coloring, slot->coloring, sol->nodeN);
+    else
+        sol->nodeN = 0;
     *read_pos = (*read_pos + 1) % BUF_LEN;
+}
+
+static int colorDistance(const char *a, const char *b, int nodeN) {
+    int overlap[COLORS][COLORS];
+    memset(overlap, 0, sizeof(overlap));
+    for (int v = 0; v < nodeN; v++)
+        overlap[(int) a[v]][(int) b[v]]++;
+
+    int matched = 0;
+    int usedA = 0, usedB = 0;
+    for (int k = 0; k < COLORS; k++) {
+        int best = -1, bestA = 0, bestB = 0;
+        for (int i = 0; i < COLORS; i++) {
+            for (int j = 0; j < COLORS; j++) {
+                if ((usedA & (1 << i)) || (usedB & (1 << j)) || overlap[i][j] <= best)
+                    continue;
+                best = overlap[i][j];
+                bestA = i;
+                bestB = j;
+            }
+        }
+        usedA |= 1 << bestA;
+        usedB |= 1 << bestB;
+        matched += best;
+    }
+    return nodeN - matched;
+}
+
+static void poolInsert(const solution_t *sol) {
+    pool_t *pool = &myshm->pool;
+    if (sem_wait(sem_pool) == -1) {
+        if (errno != EINTR)
+            error_exit("sem_wait() failed");
+        return;
+    }
+
+    if (pool->size == 0)
+        pool->nodeN = sol->nodeN;
+    if (sol->nodeN == pool->nodeN) {
+        int closest = -1, closestDist = INT_MAX, worst = -1;
+        for (int i = 0; i < pool->size; i++) {
+            const int D = colorDistance(sol->coloring, pool->coloring[i], pool->nodeN);
+            if (D < closestDist) {
+                closestDist = D;
+                closest = i;
+            }
+            if (worst < 0 || pool->cost[i] > pool->cost[worst])
+                worst = i;
+        }
+
+        int slot = -1;
+        if (closest >= 0 && closestDist <= pool->nodeN / DIVERSITY) {
+            if (sol->cost < pool->cost[closest])
+                slot = closest;
+        } else if (pool->size < POOL_LEN)
+            slot = pool->size++;
+        else if (sol->cost <= pool->cost[worst])
+            slot = worst;
+
+        if (slot >= 0) {
+            pool->cost[slot] = sol->cost;
+            memcpy(pool->coloring[slot], sol->coloring, pool->nodeN);
+        }
+    }
+
+    if (sem_post(sem_pool) == -1) {
+        if (errno != EINTR)
+            error_exit("sem_post() failed");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * @file tiny.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A batch search which colors LANES graphs of at most TINY_NODES nodes side by side.
+ */
+
+#include <string.h>
+#include "tiny.h"
+
+#define SWEEPS      4096    /**< The maximum number of sweeps over the nodes of a graph. */
+#define NOISE_ODDS  16      /**< One in NOISE_ODDS moves picks a random color. */
+
+typedef uint32_t lanes_t __attribute__((vector_size(LANES * sizeof(uint32_t))));   /**< One word per graph. */
+
+/**
+ * @brief Load a graph and a random coloring of it into a lane.
+ *
+ * @param g     The graph.
+ * @param adj   The adjacency bitmasks of all lanes.
+ * @param class The color classes of all lanes.
+ * @param lane  The lane.
+ */
+static void loadLane(const tiny_t *g, lanes_t *adj, lanes_t *class, int lane);
+
+/**
+ * @brief Store the best coloring of a lane in its graph.
+ *
+ * @param g     The graph of the lane.
+ * @param best  The best color classes of all lanes.
+ * @param lane  The lane.
+ */
+static void storeLane(tiny_t *g, const lanes_t *best, int lane);
+
+/**
+ * @brief Replace the words of every lane by their number of set bits.
+ *
+ * @details The vectors are passed by address, since passing them by value depends on the enabled instruction set.
+ *
+ * @param x The words.
+ */
+static void popcount(lanes_t *x);
+
+/**
+ * @brief Advance the xorshift generators of all lanes.
+ *
+ * @param state The generator states, which must not be zero.
+ * @param out   The vector where the next random words should be stored.
+ */
+static void nextRandom(lanes_t *state, lanes_t *out);
+
+/**
+ * @brief Count the conflicting edges of the colorings of all lanes.
+ *
+ * @param adj   The adjacency bitmasks of every node.
+ * @param class The color classes.
+ * @param nodeN The number of nodes of the largest graph.
+ * @param total The vector where the number of conflicting edges per lane should be stored.
+ */
+static void countLanes(const lanes_t *adj, const lanes_t *class, int nodeN, lanes_t *total);
+
+
+void solveTinyGraphs(tiny_t *graphs, int n) {
+    lanes_t adj[TINY_NODES], class[COLORS], best[COLORS], state, idle, record, cost, r;
+    int graph[LANES], sweeps[LANES], next = 0;
+    memset(adj, 0, sizeof(adj));
+    memset(class, 0, sizeof(class));
+    memset(best, 0, sizeof(best));
+    memset(&record, 0, sizeof(record));
+    for (int l = 0; l < LANES; l++) {
+        state[l] = random() | 1;
+        idle[l] = UINT32_MAX;
+        graph[l] = -1;
+    }
+
+    for (;;) {
+        int nodeN = 0, running = 0;
+        for (int l = 0; l < LANES; l++) {
+            if (graph[l] >= 0 && (record[l] == 0 || sweeps[l] == SWEEPS))
+                storeLane(&graphs[graph[l]], best, l);
+            if (graph[l] < 0 || record[l] == 0 || sweeps[l] == SWEEPS) {
+                graph[l] = next < n ? next++ : -1;
+                if (graph[l] >= 0)
+                    loadLane(&graphs[graph[l]], adj, class, l);
+                idle[l] = graph[l] < 0 ? UINT32_MAX : 0;
+                record[l] = UINT32_MAX;
+                sweeps[l] = 0;
+            }
+            if (graph[l] >= 0 && graphs[graph[l]].nodeN > nodeN)
+                nodeN = graphs[graph[l]].nodeN;
+            running |= graph[l] >= 0;
+        }
+        if (!running)
+            break;
+
+        for (int v = 0; v < nodeN; v++) {
+            const uint32_t BIT = 1u << v;
+            lanes_t key[COLORS];
+            nextRandom(&state, &r);
+            for (int c = 0; c < COLORS; c++) {
+                key[c] = adj[v] & class[c];
+                popcount(&key[c]);
+                key[c] = key[c] << 2 | (r >> (2 * c) & 3);
+            }
+            const lanes_t PICK01 = (lanes_t) (key[1] < key[0]);
+            const lanes_t MIN01 = (PICK01 & key[1]) | (~PICK01 & key[0]);
+            const lanes_t PICK2 = (lanes_t) (key[2] < MIN01);
+            lanes_t color = (PICK2 & 2) | (~PICK2 & PICK01 & 1);
+            const lanes_t NOISE = (lanes_t) ((r >> 8) % NOISE_ODDS == 0);
+            color = (NOISE & ((r >> 16) % COLORS)) | (~NOISE & color);
+
+            for (int c = 0; c < COLORS; c++)
+                class[c] = (class[c] & ~BIT) | ((lanes_t) (color == (uint32_t) c) & BIT);
+        }
+
+        countLanes(adj, class, nodeN, &cost);
+        const lanes_t BETTER = (lanes_t) (cost < record) & ~idle;
+        record = (BETTER & cost) | (~BETTER & record);
+        for (int c = 0; c < COLORS; c++)
+            best[c] = (BETTER & class[c]) | (~BETTER & best[c]);
+        for (int l = 0; l < LANES; l++)
+            sweeps[l]++;
+    }
+}
+
+
+static void loadLane(const tiny_t *g, lanes_t *adj, lanes_t *class, int lane) {
+    for (int v = 0; v < TINY_NODES; v++) {
+        adj[v][lane] = v < g->nodeN ? g->adj[v] : 0;
+        const int COLOR = random() % COLORS;
+        for (int c = 0; c < COLORS; c++) {
+            if (c == COLOR)
+                class[c][lane] |= 1u << v;
+            else
+                class[c][lane] &= ~(1u << v);
+        }
+    }
+}
+
+static void storeLane(tiny_t *g, const lanes_t *best, int lane) {
+    g->conflicts = 0;
+    for (int v = 0; v < g->nodeN; v++) {
+        g->colors[v] = 0;
+        for (int c = 1; c < COLORS; c++) {
+            if (best[c][lane] >> v & 1)
+                g->colors[v] = c;
+        }
+    }
+    for (int u = 0; u < g->nodeN; u++) {
+        for (int v = u + 1; v < g->nodeN; v++)
+            g->conflicts += (g->adj[u] >> v & 1) && g->colors[u] == g->colors[v];
+    }
+}
+
+
+static void popcount(lanes_t *x) {
+    lanes_t y = *x - (*x >> 1 & 0x55555555);
+    y = (y & 0x33333333) + (y >> 2 & 0x33333333);
+    y = (y + (y >> 4)) & 0x0f0f0f0f;
+    *x = y * 0x01010101 >> 24;
+}
+
+static void nextRandom(lanes_t *state, lanes_t *out) {
+    lanes_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    *out = x;
+}
+
+static void countLanes(const lanes_t *adj, const lanes_t *class, int nodeN, lanes_t *total) {
+    lanes_t sum = {0};
+    for (int v = 0; v < nodeN; v++) {
+        lanes_t same = {0};
+        for (int c = 0; c < COLORS; c++)
+            same |= -(class[c] >> v & 1) & class[c];
+        same &= adj[v];
+        popcount(&same);
+        sum += same;
+    }
+    *total = sum >> 1;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file tiny.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A batch search which colors LANES graphs of at most TINY_NODES nodes side by side.
+ *
+ * @details Every graph is a set of adjacency bitmasks and every coloring a bitmask per color, so the number of
+ * neighbors of a node with color c is the population count of adj[v] & class[c]. The graphs of a batch occupy the
+ * lanes of GCC vector types: all lanes sweep over the nodes in the same order and recolor each node to its least
+ * conflicting color, or with a small probability to a random one, using per-lane xorshift random numbers. The
+ * default build targets the baseline instruction set, so the vector operations compile to SSE2 on x86-64; building
+ * with ARCH set, for example make ARCH=native, lets them compile to AVX2 or AVX-512 on targets which support them.
+ * As soon as the graph of a lane is properly colored or has used up its sweep budget, its best coloring is stored
+ * and the next graph of the batch is loaded into the lane, so a hard graph doesn't hold up the others.
+ */
+
+#pragma once
+#include <stdint.h>
+#include "graph.h"
+
+#define TINY_NODES  32  /**< The maximum number of nodes of a tiny graph. */
+#define LANES       16  /**< The number of graphs searched side by side. */
+
+typedef struct tiny {               /**< A graph with at most TINY_NODES nodes. */
+    int nodeN;                      /**< The number of nodes. */
+    uint32_t adj[TINY_NODES];       /**< Bit u of adj[v] is set if u and v are adjacent. Self-loops are left out. */
+    uint32_t loops;                 /**< Bit v is set if v has a self-loop. */
+    char colors[TINY_NODES];        /**< The best coloring found. */
+    int conflicts;                  /**< The number of conflicting edges of the best coloring without the self-loops. */
+} tiny_t;
+
+/**
+ * @brief Search colorings of a batch of tiny graphs.
+ *
+ * @details Fills colors and conflicts of every graph.
+ *
+ * @param graphs    The graphs.
+ * @param n         The number of graphs.
+ */
+void solveTinyGraphs(tiny_t *graphs, int n);
@@ -0,0 +1,702 @@
+/**
+ * @file tree.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A dynamic program over a tree decomposition which proves the minimum number of removed edges.
+ */
+
+#include <string.h>
+#include <limits.h>
+#include "parallel.h"
+#include "tree.h"
+
+#define NODES_PER_THREAD    64          /**< The minimum number of small bags which justify another thread. */
+#define ENTRIES_PER_THREAD  (1 << 14)   /**< The minimum number of table entries which justify another thread. */
+#define TIE_SCAN            8           /**< The number of tied nodes the maximum cardinality search compares. */
+
+static const int POW3[TREE_WIDTH + 1] = {   /**< The place values of the base 3 digits of a table index. */
+    1, 3, 9, 27, 81, 243, 729, 2187, 6561, 19683, 59049, 177147, 531441, 1594323, 4782969
+};
+
+enum ordering {     /**< The elimination orders a decomposition can be built from. */
+    ORDER_GREEDY,   /**< Min-fill on small graphs and min-degree on large ones. */
+    ORDER_CARDINALITY   /**< The reverse of a maximum cardinality search. */
+};
+
+typedef struct elimination {    /**< The graph while its nodes are eliminated. */
+    int **adj;                  /**< The neighbors of each node, including eliminated ones until they are purged. */
+    int *len;                   /**< The length of each neighbor list. */
+    int *cap;                   /**< The capacity of each neighbor list. */
+    int *degree;                /**< The number of neighbors which are not eliminated yet. */
+    char *gone;                 /**< Set for eliminated nodes. */
+    int *fill;                  /**< The fill edges the elimination of each node would add or -1 if unknown. */
+    int *bucket;                /**< The degree bucket each node is in or -1. */
+    int *next;                  /**< The next node in the same bucket or -1. */
+    int *prev;                  /**< The previous node in the same bucket or -1. */
+    int head[TREE_WIDTH + 1];   /**< The first node of the bucket of each degree up to TREE_WIDTH or -1. */
+} elimination_t;
+
+typedef struct tree {           /**< The tree decomposition and the tables of the dynamic program. */
+    const graph_t *graph;       /**< The graph. */
+    int *order;                 /**< The node eliminated at each position, which is forgotten by its bag. */
+    int *position;              /**< The position of each node. */
+    int *offset;                /**< The rest of the bag at position i is scope[offset[i]] till scope[offset[i+1]-1]. */
+    int *scope;                 /**< The bags without their forgotten nodes. */
+    int *parent;                /**< The position of the parent bag or -1. */
+    int *childOffset;           /**< The children of the bag at position i are child[childOffset[i]] and on. */
+    int *child;                 /**< The positions of the child bags. */
+    int **table;                /**< The table of each bag until its parent is solved. */
+    unsigned char **choice;     /**< The best colors of the forgotten node of each bag, four per byte. */
+    int failed;                 /**< Set if a thread could not allocate its buffers. */
+} tree_t;
+
+typedef struct bucket {     /**< The nodes of a maximum cardinality search bucketed by their numbered neighbors. */
+    int *head;              /**< The first node of each bucket or -1. */
+    int *tail;              /**< The last node of each bucket or -1. */
+    int *next;              /**< The next node in the same bucket or -1. */
+    int *prev;              /**< The previous node in the same bucket or -1. */
+    int *count;             /**< The numbered neighbors of each node or -1 once it is numbered. */
+} bucket_t;
+
+typedef struct level {          /**< The bags of one height of the tree. */
+    tree_t *tree;               /**< The tree. */
+    const int *bag;             /**< The positions of the bags. */
+} level_t;
+
+typedef struct bag {            /**< A single bag whose table is split by entries. */
+    tree_t *tree;               /**< The tree. */
+    int pos;                    /**< The position of the bag. */
+} bag_t;
+
+/**
+ * @brief Compute an elimination order and the bags it induces.
+ *
+ * @param g     The graph.
+ * @param t     The tree whose order, position, offset, scope and parent arrays should be allocated and filled.
+ * @param how   The elimination order.
+ * @return Returns the width of the decomposition, -2 if a bag would exceed TREE_WIDTH + 1 nodes and -3 if memory
+ * could not be allocated.
+ */
+static int decompose(const graph_t *g, tree_t *t, enum ordering how);
+
+/**
+ * @brief Compute the elimination order of a maximum cardinality search.
+ *
+ * @details The search numbers the nodes one by one, always taking the node with the most numbered neighbors, and the
+ * nodes are eliminated in reverse. Ties go to the node with the fewest neighbors among the first TIE_SCAN nodes of
+ * the bucket, which is kept in first-in first-out order. On long grid-like graphs it sweeps across the short side,
+ * where the greedy orders leave scattered separators that merge into wide bags.
+ *
+ * @param g     The graph.
+ * @param order The buffer where the order should be stored.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int cardinalityOrder(const graph_t *g, int *order);
+
+/**
+ * @brief Append a node to the bucket of its count.
+ *
+ * @param b The buckets.
+ * @param v The node.
+ */
+static void linkNode(bucket_t *b, int v);
+
+/**
+ * @brief Remove a node from the bucket of its count.
+ *
+ * @param b The buckets.
+ * @param v The node.
+ */
+static void unlinkNode(bucket_t *b, int v);
+
+/**
+ * @brief Pick the next node to eliminate.
+ *
+ * @param e         The elimination state.
+ * @param minFill   Set if the node with the fewest fill edges should be picked instead of the one with the fewest
+ * neighbors.
+ * @return Returns the node or -1 if every remaining node has more than TREE_WIDTH neighbors.
+ */
+static int pickNode(elimination_t *e, int minFill);
+
+/**
+ * @brief Move a node into the bucket of its current degree, or out of all buckets if it exceeds TREE_WIDTH.
+ *
+ * @param e The elimination state.
+ * @param v The node.
+ */
+static void rebucket(elimination_t *e, int v);
+
+/**
+ * @brief Check whether two remaining nodes are adjacent.
+ *
+ * @param e The elimination state.
+ * @param a The first node.
+ * @param b The second node.
+ * @return Returns non-zero if they are adjacent.
+ */
+static int isAdjacent(const elimination_t *e, int a, int b);
+
+/**
+ * @brief Append a node to the neighbor list of another.
+ *
+ * @param e The elimination state.
+ * @param a The node whose list should be extended.
+ * @param b The new neighbor.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+static int addNeighbor(elimination_t *e, int a, int b);
+
+/**
+ * @brief Count the fill edges the elimination of a node would add.
+ *
+ * @param e The elimination state.
+ * @param v The node, which has at most TREE_WIDTH neighbors.
+ * @return Returns the number of non-adjacent pairs of remaining neighbors.
+ */
+static int countFill(const elimination_t *e, int v);
+
+/**
+ * @brief Solve the small bags of a height. Implements range_fn.
+ *
+ * @details Bags with ENTRIES_PER_THREAD entries or more are skipped and split by entries afterwards.
+ *
+ * @param arg       The level_t.
+ * @param from      The index of the first bag.
+ * @param to        The index after the last bag.
+ * @param thread    The index of the chunk.
+ */
+static void solveBags(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Solve a range of entries of a single bag. Implements range_fn.
+ *
+ * @param arg       The bag_t.
+ * @param from      The first entry.
+ * @param to        The entry after the last one.
+ * @param thread    The index of the chunk.
+ */
+static void solveRange(void *arg, int from, int to, int thread);
+
+/**
+ * @brief Fill a range of the table of a bag from the tables of its children.
+ *
+ * @details The entries are walked in odometer order over the digits of the bag, which updates the child indices and
+ * the color counts of the neighbors incrementally. For every entry the forgotten node takes the color with the
+ * fewest conflicts, counting the edges to its neighbors in the bag and the child tables of that coloring.
+ *
+ * @param t     The tree.
+ * @param i     The position of the bag.
+ * @param from  The first entry.
+ * @param to    The entry after the last one.
+ */
+static void solveEntries(tree_t *t, int i, int from, int to);
+
+/**
+ * @brief Free the arrays of a tree decomposition.
+ *
+ * @param t The tree.
+ * @param n The number of positions.
+ */
+static void freeTree(tree_t *t, int n);
+
+
+int treeSearch(const graph_t *g, report_fn report, char *colors) {
+    const int N = g->nodeN;
+    tree_t t, alt;
+    memset(&t, 0, sizeof(t));
+    memset(&alt, 0, sizeof(alt));
+    t.graph = alt.graph = g;
+    int width = decompose(g, &t, ORDER_GREEDY);
+    const int ALT = decompose(g, &alt, ORDER_CARDINALITY);
+    if (ALT >= 0 && (width < 0 || ALT < width)) {
+        const tree_t SWAP = t;
+        t = alt;
+        alt = SWAP;
+        width = ALT;
+    }
+    freeTree(&alt, 0);
+    int status = width >= 0 ? 0 : (width == -3 || ALT == -3 ? -3 : -2);
+    int *height = calloc(N + 1, sizeof(int)), *levelOffset = calloc(N + 2, sizeof(int));
+    int *levelBag = malloc((N > 0 ? N : 1) * sizeof(int));
+    t.childOffset = calloc(N + 1, sizeof(int));
+    t.child = malloc((N > 0 ? N : 1) * sizeof(int));
+    t.table = calloc(N > 0 ? N : 1, sizeof(int *));
+    t.choice = calloc(N > 0 ? N : 1, sizeof(unsigned char *));
+    if (status == 0 && (height == NULL || levelOffset == NULL || levelBag == NULL || t.childOffset == NULL
+            || t.child == NULL || t.table == NULL || t.choice == NULL))
+        status = -3;
+
+    int maxHeight = 0;
+    for (int i = 0; i < N && status == 0; i++) {
+        if (t.parent[i] < 0)
+            continue;
+        t.childOffset[t.parent[i] + 1]++;
+        if (height[i] + 1 > height[t.parent[i]])
+            height[t.parent[i]] = height[i] + 1;
+    }
+    for (int i = 0; i < N && status == 0; i++) {
+        t.childOffset[i+1] += t.childOffset[i];
+        levelOffset[height[i] + 1]++;
+        if (height[i] > maxHeight)
+            maxHeight = height[i];
+    }
+    for (int h = 0; h <= maxHeight && status == 0; h++)
+        levelOffset[h+1] += levelOffset[h];
+    for (int i = 0; i < N && status == 0; i++) {
+        levelBag[levelOffset[height[i]]++] = i;
+        if (t.parent[i] >= 0)
+            t.child[t.childOffset[t.parent[i]]++] = i;
+    }
+    for (int h = maxHeight; h >= 0 && status == 0; h--)
+        levelOffset[h+1] = levelOffset[h];
+    for (int i = N; i > 0 && status == 0; i--)
+        t.childOffset[i] = t.childOffset[i-1];
+    if (status == 0) {
+        levelOffset[0] = 0;
+        t.childOffset[0] = 0;
+    }
+
+    for (int h = 0; h <= maxHeight && N > 0 && status == 0; h++) {
+        if (report(NULL) != 0) {
+            status = -1;
+            break;
+        }
+        const int FIRST = levelOffset[h], COUNT = levelOffset[h+1] - FIRST;
+        for (int k = FIRST; k < FIRST + COUNT; k++) {
+            const int I = levelBag[k], SIZE = POW3[t.offset[I+1] - t.offset[I]];
+            t.table[I] = malloc(SIZE * sizeof(int));
+            t.choice[I] = calloc((SIZE + 3) / 4, 1);
+            if (t.table[I] == NULL || t.choice[I] == NULL)
+                status = -3;
+        }
+        if (status != 0)
+            break;
+
+        level_t level = {&t, &levelBag[FIRST]};
+        parallelFor(COUNT, NODES_PER_THREAD, solveBags, &level);
+        for (int k = FIRST; k < FIRST + COUNT; k++) {
+            bag_t bag = {&t, levelBag[k]};
+            const int SIZE = POW3[t.offset[bag.pos+1] - t.offset[bag.pos]];
+            if (SIZE >= ENTRIES_PER_THREAD)
+                parallelFor(SIZE, ENTRIES_PER_THREAD, solveRange, &bag);
+        }
+        if (t.failed)
+            status = -3;
+
+        for (int k = FIRST; k < FIRST + COUNT; k++) {
+            const int I = levelBag[k];
+            for (int c = t.childOffset[I]; c < t.childOffset[I+1]; c++) {
+                free(t.table[t.child[c]]);
+                t.table[t.child[c]] = NULL;
+            }
+        }
+    }
+
+    if (status == 0) {
+        for (int i = 0; i < N; i++) {
+            if (t.parent[i] < 0)
+                status += t.table[i][0];
+        }
+        for (int i = N - 1; i >= 0; i--) {
+            int idx = 0;
+            for (int k = t.offset[i+1] - 1; k >= t.offset[i]; k--)
+                idx = idx * COLORS + colors[t.scope[k]];
+            colors[t.order[i]] = t.choice[i][idx / 4] >> (2 * (idx % 4)) & 3;
+        }
+    }
+
+    free(height);
+    free(levelOffset);
+    free(levelBag);
+    freeTree(&t, N);
+    return status;
+}
+
+
+static int decompose(const graph_t *g, tree_t *t, enum ordering how) {
+    const int N = g->nodeN, SLOTS = N > 0 ? N : 1, MIN_FILL = how == ORDER_GREEDY && N <= FILL_NODES;
+    elimination_t e;
+    memset(e.head, -1, sizeof(e.head));
+    e.adj = calloc(SLOTS, sizeof(int *));
+    e.len = malloc(SLOTS * sizeof(int));
+    e.cap = malloc(SLOTS * sizeof(int));
+    e.degree = malloc(SLOTS * sizeof(int));
+    e.gone = calloc(SLOTS, 1);
+    e.fill = malloc(SLOTS * sizeof(int));
+    e.bucket = malloc(SLOTS * sizeof(int));
+    e.next = malloc(SLOTS * sizeof(int));
+    e.prev = malloc(SLOTS * sizeof(int));
+    int scopeCap = 2 * SLOTS;
+    t->order = malloc(SLOTS * sizeof(int));
+    t->position = malloc(SLOTS * sizeof(int));
+    t->offset = malloc((N + 1) * sizeof(int));
+    t->scope = malloc(scopeCap * sizeof(int));
+    t->parent = malloc(SLOTS * sizeof(int));
+    int status = 0;
+    if (e.adj == NULL || e.len == NULL || e.cap == NULL || e.degree == NULL || e.gone == NULL || e.fill == NULL
+            || e.bucket == NULL || e.next == NULL || e.prev == NULL || t->order == NULL || t->position == NULL
+            || t->offset == NULL || t->scope == NULL || t->parent == NULL)
+        status = -3;
+
+    for (int v = 0; v < N && status == 0; v++) {
+        e.degree[v] = e.len[v] = g->offset[v+1] - g->offset[v];
+        e.cap[v] = e.len[v] + 4;
+        if ((e.adj[v] = malloc(e.cap[v] * sizeof(int))) == NULL) {
+            status = -3;
+            break;
+        }
+        cursor_t cur;
+        initCursor(&cur, g, v);
+        for (int k = 0, u; (u = nextNeighbor(&cur)) >= 0; k++)
+            e.adj[v][k] = u;
+        e.fill[v] = -1;
+        e.bucket[v] = -1;
+        rebucket(&e, v);
+    }
+
+    if (status == 0) {
+        t->offset[0] = 0;
+        if (how == ORDER_CARDINALITY && cardinalityOrder(g, t->order) < 0)
+            status = -3;
+    }
+    int width = 0;
+    for (int i = 0; i < N && status == 0; i++) {
+        const int V = how == ORDER_CARDINALITY ? t->order[i] : pickNode(&e, MIN_FILL);
+        if (V < 0 || e.degree[V] > TREE_WIDTH) {
+            status = -2;
+            break;
+        }
+        e.degree[V] = INT_MAX;
+        rebucket(&e, V);
+        e.gone[V] = 1;
+        t->order[i] = V;
+        t->position[V] = i;
+
+        int live[TREE_WIDTH], d = 0;
+        for (int k = 0; k < e.len[V]; k++) {
+            if (!e.gone[e.adj[V][k]])
+                live[d++] = e.adj[V][k];
+        }
+        if (t->offset[i] + d > scopeCap) {
+            int *scope = realloc(t->scope, 2 * scopeCap * sizeof(int));
+            if (scope == NULL) {
+                status = -3;
+                break;
+            }
+            t->scope = scope;
+            scopeCap *= 2;
+        }
+        memcpy(&t->scope[t->offset[i]], live, d * sizeof(int));
+        if (d > width)
+            width = d;
+        t->offset[i+1] = t->offset[i] + d;
+
+        for (int a = 0; a < d && status == 0; a++) {
+            for (int b = a + 1; b < d && status == 0; b++) {
+                if (isAdjacent(&e, live[a], live[b]))
+                    continue;
+                if (addNeighbor(&e, live[a], live[b]) < 0 || addNeighbor(&e, live[b], live[a]) < 0)
+                    status = -3;
+                e.degree[live[a]]++;
+                e.degree[live[b]]++;
+            }
+        }
+        for (int a = 0; a < d; a++) {
+            const int A = live[a];
+            e.degree[A]--;
+            rebucket(&e, A);
+            if (e.len[A] > 2 * e.degree[A] + 4) {
+                int len = 0;
+                for (int k = 0; k < e.len[A]; k++) {
+                    if (!e.gone[e.adj[A][k]])
+                        e.adj[A][len++] = e.adj[A][k];
+                }
+                e.len[A] = len;
+            }
+            e.fill[A] = -1;
+            for (int k = 0; k < e.len[A] && MIN_FILL; k++)
+                e.fill[e.adj[A][k]] = -1;
+        }
+    }
+
+    for (int i = 0; i < N && status == 0; i++) {
+        t->parent[i] = -1;
+        for (int k = t->offset[i]; k < t->offset[i+1]; k++) {
+            if (t->parent[i] < 0 || t->position[t->scope[k]] < t->parent[i])
+                t->parent[i] = t->position[t->scope[k]];
+        }
+    }
+
+    for (int v = 0; v < N && e.adj != NULL; v++)
+        free(e.adj[v]);
+    free(e.adj);
+    free(e.len);
+    free(e.cap);
+    free(e.degree);
+    free(e.gone);
+    free(e.fill);
+    free(e.bucket);
+    free(e.next);
+    free(e.prev);
+    return status < 0 ? status : width;
+}
+
+static int cardinalityOrder(const graph_t *g, int *order) {
+    const int N = g->nodeN, SLOTS = N > 0 ? N : 1;
+    int maxDegree = 0;
+    for (int v = 0; v < N; v++) {
+        if (g->offset[v+1] - g->offset[v] > maxDegree)
+            maxDegree = g->offset[v+1] - g->offset[v];
+    }
+    bucket_t b = {malloc((maxDegree + 1) * sizeof(int)), malloc((maxDegree + 1) * sizeof(int)),
+        malloc(SLOTS * sizeof(int)), malloc(SLOTS * sizeof(int)), calloc(SLOTS, sizeof(int))};
+    int status = 0;
+    if (b.head == NULL || b.tail == NULL || b.next == NULL || b.prev == NULL || b.count == NULL)
+        status = -1;
+    else {
+        memset(b.head, -1, (maxDegree + 1) * sizeof(int));
+        memset(b.tail, -1, (maxDegree + 1) * sizeof(int));
+    }
+
+    for (int v = 0; v < N && status == 0; v++)
+        linkNode(&b, v);
+    for (int k = N - 1, top = 0; k >= 0 && status == 0; k--) {
+        while (b.head[top] < 0)
+            top--;
+        int V = b.head[top];
+        for (int v = b.next[V], scan = 1; v >= 0 && scan < TIE_SCAN; v = b.next[v], scan++) {
+            if (g->offset[v+1] - g->offset[v] < g->offset[V+1] - g->offset[V])
+                V = v;
+        }
+        unlinkNode(&b, V);
+        b.count[V] = -1;
+        order[k] = V;
+        cursor_t cur;
+        initCursor(&cur, g, V);
+        for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+            if (b.count[u] < 0)
+                continue;
+            unlinkNode(&b, u);
+            b.count[u]++;
+            linkNode(&b, u);
+            if (b.count[u] > top)
+                top = b.count[u];
+        }
+    }
+    free(b.head);
+    free(b.tail);
+    free(b.next);
+    free(b.prev);
+    free(b.count);
+    return status;
+}
+
+static void linkNode(bucket_t *b, int v) {
+    const int C = b->count[v];
+    b->next[v] = -1;
+    b->prev[v] = b->tail[C];
+    if (b->tail[C] >= 0)
+        b->next[b->tail[C]] = v;
+    else
+        b->head[C] = v;
+    b->tail[C] = v;
+}
+
+static void unlinkNode(bucket_t *b, int v) {
+    const int C = b->count[v];
+    if (b->prev[v] >= 0)
+        b->next[b->prev[v]] = b->next[v];
+    else
+        b->head[C] = b->next[v];
+    if (b->next[v] >= 0)
+        b->prev[b->next[v]] = b->prev[v];
+    else
+        b->tail[C] = b->prev[v];
+}
+
+static int pickNode(elimination_t *e, int minFill) {
+    int best = -1, bestFill = INT_MAX;
+    for (int d = 0; d <= TREE_WIDTH; d++) {
+        for (int v = e->head[d]; v >= 0; v = e->next[v]) {
+            if (!minFill)
+                return v;
+            if (e->fill[v] < 0)
+                e->fill[v] = countFill(e, v);
+            if (e->fill[v] == 0)
+                return v;
+            if (e->fill[v] < bestFill) {
+                bestFill = e->fill[v];
+                best = v;
+            }
+        }
+    }
+    return best;
+}
+
+static void rebucket(elimination_t *e, int v) {
+    const int OLD = e->bucket[v], NEW = e->degree[v] <= TREE_WIDTH ? e->degree[v] : -1;
+    if (OLD == NEW)
+        return;
+    if (OLD >= 0) {
+        if (e->prev[v] >= 0)
+            e->next[e->prev[v]] = e->next[v];
+        else
+            e->head[OLD] = e->next[v];
+        if (e->next[v] >= 0)
+            e->prev[e->next[v]] = e->prev[v];
+    }
+    e->bucket[v] = NEW;
+    if (NEW >= 0) {
+        e->prev[v] = -1;
+        e->next[v] = e->head[NEW];
+        if (e->head[NEW] >= 0)
+            e->prev[e->head[NEW]] = v;
+        e->head[NEW] = v;
+    }
+}
+
+static int isAdjacent(const elimination_t *e, int a, int b) {
+    if (e->len[a] > e->len[b]) {
+        const int SWAP = a;
+        a = b;
+        b = SWAP;
+    }
+    for (int k = 0; k < e->len[a]; k++) {
+        if (e->adj[a][k] == b)
+            return 1;
+    }
+    return 0;
+}
+
+static int addNeighbor(elimination_t *e, int a, int b) {
+    if (e->len[a] == e->cap[a]) {
+        int *adj = realloc(e->adj[a], 2 * e->cap[a] * sizeof(int));
+        if (adj == NULL)
+            return -1;
+        e->adj[a] = adj;
+        e->cap[a] *= 2;
+    }
+    e->adj[a][e->len[a]++] = b;
+    return 0;
+}
+
+static int countFill(const elimination_t *e, int v) {
+    int live[TREE_WIDTH], d = 0, fill = 0;
+    for (int k = 0; k < e->len[v]; k++) {
+        if (!e->gone[e->adj[v][k]])
+            live[d++] = e->adj[v][k];
+    }
+    for (int a = 0; a < d; a++) {
+        for (int b = a + 1; b < d; b++)
+            fill += !isAdjacent(e, live[a], live[b]);
+    }
+    return fill;
+}
+
+static void solveBags(void *arg, int from, int to, int thread) {
+    const level_t *l = arg;
+    for (int k = from; k < to; k++) {
+        const int I = l->bag[k], SIZE = POW3[l->tree->offset[I+1] - l->tree->offset[I]];
+        if (SIZE < ENTRIES_PER_THREAD)
+            solveEntries(l->tree, I, 0, SIZE);
+    }
+}
+
+static void solveRange(void *arg, int from, int to, int thread) {
+    const bag_t *b = arg;
+    solveEntries(b->tree, b->pos, from, to);
+}
+
+static void solveEntries(tree_t *t, int i, int from, int to) {
+    const int V = t->order[i], S = t->offset[i+1] - t->offset[i], C = t->childOffset[i+1] - t->childOffset[i];
+    const int *scope = &t->scope[t->offset[i]];
+    int *delta = calloc((size_t) C * (S + 2) + 1, sizeof(int));
+    const int **table = malloc((C > 0 ? C : 1) * sizeof(int *));
+    if (delta == NULL || table == NULL) {
+        __atomic_store_n(&t->failed, 1, __ATOMIC_RELAXED);
+        free(delta);
+        free(table);
+        return;
+    }
+
+    int *index = &delta[(size_t) C * (S + 1)];
+    for (int k = 0; k < C; k++) {
+        const int P = t->child[t->childOffset[i] + k];
+        table[k] = t->table[P];
+        for (int q = 0; q < t->offset[P+1] - t->offset[P]; q++) {
+            const int X = t->scope[t->offset[P] + q];
+            int j = 0;
+            while (X != V && scope[j] != X)
+                j++;
+            delta[k * (S + 1) + (X == V ? 0 : j + 1)] = POW3[q];
+        }
+    }
+    int neighbor[TREE_WIDTH + 1] = {0}, digit[TREE_WIDTH + 1], count[COLORS] = {0};
+    cursor_t cur;
+    initCursor(&cur, t->graph, V);
+    for (int u; (u = nextNeighbor(&cur)) >= 0;) {
+        for (int j = 0; j < S && t->position[u] > i; j++) {
+            if (scope[j] == u)
+                neighbor[j+1] = 1;
+        }
+    }
+    for (int j = 1, m = from; j <= S; j++, m /= COLORS) {
+        digit[j] = m % COLORS;
+        count[digit[j]] += neighbor[j];
+        for (int k = 0; k < C; k++)
+            index[k] += digit[j] * delta[k * (S + 1) + j];
+    }
+
+    unsigned int bits = 0;
+    for (int m = from; m < to; m++) {
+        int best = INT_MAX, pick = 0;
+        for (int c = 0; c < COLORS; c++) {
+            int cost = count[c];
+            for (int k = 0; k < C; k++)
+                cost += table[k][index[k] + c * delta[k * (S + 1)]];
+            if (cost < best) {
+                best = cost;
+                pick = c;
+            }
+        }
+        t->table[i][m] = best;
+        bits |= pick << (2 * (m % 4));
+        if (m % 4 == 3 || m == to - 1) {
+            __atomic_fetch_or(&t->choice[i][m / 4], (unsigned char) bits, __ATOMIC_RELAXED);
+            bits = 0;
+        }
+
+        for (int j = 1; j <= S; j++) {
+            count[digit[j]] -= neighbor[j];
+            const int STEP = digit[j] < COLORS - 1 ? 1 : 1 - COLORS;
+            digit[j] += STEP;
+            count[digit[j]] += neighbor[j];
+            for (int k = 0; k < C; k++)
+                index[k] += STEP * delta[k * (S + 1) + j];
+            if (STEP == 1)
+                break;
+        }
+    }
+    free(delta);
+    free(table);
+}
+
+static void freeTree(tree_t *t, int n) {
+    for (int i = 0; i < n; i++) {
+        if (t->table != NULL)
+            free(t->table[i]);
+        if (t->choice != NULL)
+            free(t->choice[i]);
+    }
+    free(t->order);
+    free(t->position);
+    free(t->offset);
+    free(t->scope);
+    free(t->parent);
+    free(t->childOffset);
+    free(t->child);
+    free(t->table);
+    free(t->choice);
+}
@@ -0,0 +1,39 @@
+/**
+ * @file tree.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A dynamic program over a tree decomposition which proves the minimum number of removed edges.
+ *
+ * @details The nodes are eliminated one by one, each time the one with the least fill edges on graphs of up to
+ * FILL_NODES nodes and the one with the least neighbors on larger graphs, and the remaining neighbors of an
+ * eliminated node become a clique. The bag of a node holds the node and these neighbors, its parent is the bag of the
+ * first of them to be eliminated, which yields a tree decomposition of width w, the largest bag size minus one. The
+ * reverse of a maximum cardinality search is eliminated as well, and the narrower decomposition is kept.
+ * Every bag is one step of a nice tree decomposition: the tables of its children are joined and introduced into the
+ * bag, the conflicts of the edges from the node to the bag are added and the node is forgotten by minimizing over its
+ * color. A table holds the fewest conflicts below the bag for every coloring of the rest of the bag, stored
+ * contiguously and indexed by the coloring as base 3 number, so the whole program takes O(3^w * n) steps. Bags on the
+ * same height of the tree are independent and split across threads, and large tables are split by entries. The best
+ * color of the forgotten node is kept for every entry, so a top down pass turns the minimum into a coloring.
+ */
+
+#pragma once
+#include "graph.h"
+
+#define TREE_WIDTH  14      /**< The maximum width of the decomposition. Tables have at most 3^TREE_WIDTH entries. */
+#define FILL_NODES  8192    /**< The maximum number of nodes for the min-fill ordering. */
+
+/**
+ * @brief Find a coloring with the minimum number of conflicts.
+ *
+ * @details The callback is only polled with NULL, between the heights of the tree, and ends the search early if it
+ * returns non-zero.
+ *
+ * @param g         The graph.
+ * @param report    The callback which is polled for termination.
+ * @param colors    The buffer where an optimal coloring should be stored.
+ * @return Returns the minimum number of conflicting edges, -1 if the callback ended the search, -2 if the
+ * decomposition is wider than TREE_WIDTH and -3 if memory could not be allocated.
+ */
+int treeSearch(const graph_t *g, report_fn report, char *colors);
@@ -0,0 +1,160 @@
+/**
+ * @file weighted.c
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A breakout local search whose edge weights are shared between all generators.
+ */
+
+#include <limits.h>
+#include "common.h"
+#include "localsearch.h"
+#include "construct.h"
+#include "weighted.h"
+
+#define POLL_PERIOD     1024    /**< The number of iterations between two polls of the callback. */
+#define SYNC_PERIOD     256     /**< The number of local minima between two reloads of the shared weights. */
+#define STALL_LIMIT     4096    /**< The number of local minima without improvement after which the search restarts. */
+
+/**
+ * @brief Compute the shared weight slot of an edge.
+ *
+ * @details The slot only depends on the unordered pair of nodes, so every generator maps an edge to the same slot.
+ *
+ * @param e The edge.
+ * @return Returns the slot index.
+ */
+static unsigned int weightSlot(const struct edge *e);
+
+/**
+ * @brief Replace the local edge weights with the shared ones and re-evaluate the current coloring.
+ *
+ * @details Global variables: myshm.
+ *
+ * @param s     The weighted search state.
+ * @param slots The shared weight slot of each edge.
+ */
+static void loadWeights(search_t *s, const unsigned int *slots);
+
+/**
+ * @brief Bump the weight of every conflicting edge locally and in the shared memory.
+ *
+ * @details The generator whose bumps cross a multiple of SMOOTH_PERIOD smooths the shared weights.
+ * Global variables: myshm.
+ *
+ * @param s     The weighted search state.
+ * @param slots The shared weight slot of each edge.
+ */
+static void bumpConflicts(search_t *s, const unsigned int *slots);
+
+/**
+ * @brief Decay all shared weights by a quarter.
+ *
+ * @details Updates from other generators which race with the decay are lost, which only makes the decay slightly
+ * stronger. Global variables: myshm.
+ */
+static void smoothWeights(void);
+
+
+int weightedSearch(const graph_t *g, report_fn report) {
+    search_t s;
+    if (initSearch(&s, g, 1) < 0)
+        return -1;
+    unsigned int *slots = malloc((g->edgeN > 0 ? g->edgeN : 1) * sizeof(unsigned int));
+    if (slots == NULL) {
+        freeSearch(&s);
+        return -1;
+    }
+    for (int i = 0; i < g->edgeN; i++)
+        slots[i] = weightSlot(&g->edges[i]);
+
+    int best = INT_MAX;
+    int quit = 0;
+    long iter = 0;
+    while (quit == 0) {
+        initialColoring(g, s.colors);
+        loadWeights(&s, slots);
+        int runBest = s.conflicts, stall = 0, minima = 0;
+
+        while (quit == 0 && stall < STALL_LIMIT) {
+            if (s.conflicts < best) {
+                best = s.conflicts;
+                quit = report(s.colors);
+            }
+            if (++iter % POLL_PERIOD == 0 && quit == 0)
+                quit = report(NULL);
+            if (s.conflicts == 0)
+                break;
+
+            int v, c;
+            if (findBestMove(&s, &v, &c) < 0) {
+                moveNode(&s, v, c);
+                if (s.conflicts < runBest) {
+                    runBest = s.conflicts;
+                    stall = 0;
+                }
+                continue;
+            }
+
+            stall++;
+            if (tryKempeMove(&s, s.cost) == 0)
+                continue;
+            if (++minima % SYNC_PERIOD == 0)
+                loadWeights(&s, slots);
+            bumpConflicts(&s, slots);
+        }
+    }
+
+    free(slots);
+    freeSearch(&s);
+    return 0;
+}
+
+
+static unsigned int weightSlot(const struct edge *e) {
+    unsigned int a = e->nodeU, b = e->nodeV;
+    if (a > b) {
+        unsigned int t = a;
+        a = b;
+        b = t;
+    }
+    unsigned int h = a * 2654435761u ^ (b + 0x9e3779b9u + (a << 6) + (a >> 2));
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h % WEIGHT_LEN;
+}
+
+static void loadWeights(search_t *s, const unsigned int *slots) {
+    for (int i = 0; i < s->graph->edgeN; i++)
+        s->weight[i] = 1 + __atomic_load_n(&myshm->weight[slots[i]], __ATOMIC_RELAXED);
+    loadColoring(s, s->colors);
+}
+
+static void bumpConflicts(search_t *s, const unsigned int *slots) {
+    const graph_t *g = s->graph;
+    unsigned int bumps = 0;
+    for (int i = 0; i < s->confN; i++) {
+        const int V = s->confList[i];
+        for (int h = g->offset[V]; h < g->offset[V+1]; h++) {
+            const int U = g->adj[h];
+            if (U < V || s->colors[U] != s->colors[V])
+                continue;
+            addWeight(s, g->adjEdge[h], 1);
+            __atomic_fetch_add(&myshm->weight[slots[g->adjEdge[h]]], 1, __ATOMIC_RELAXED);
+            bumps++;
+        }
+    }
+
+    const unsigned int BEFORE = __atomic_fetch_add(&myshm->weight_bumps, bumps, __ATOMIC_RELAXED);
+    if (BEFORE / SMOOTH_PERIOD != (BEFORE + bumps) / SMOOTH_PERIOD)
+        smoothWeights();
+}
+
+static void smoothWeights(void) {
+    for (int i = 0; i < WEIGHT_LEN; i++) {
+        const unsigned int W = __atomic_load_n(&myshm->weight[i], __ATOMIC_RELAXED);
+        if (W > 0)
+            __atomic_store_n(&myshm->weight[i], W - (W + 3) / 4, __ATOMIC_RELAXED);
+    }
+}
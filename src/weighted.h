@@ -0,0 +1,29 @@
+/**
+ * @file weighted.h
+ * @author Steven Kolamkuzhiyil <stevenkolamkuzhiyil@gmail.com>
+ * @date 18.10.2026
+ *
+ * @brief A breakout local search whose edge weights are shared between all generators.
+ *
+ * @details The search minimizes the weighted number of conflicting edges. Whenever it gets stuck in a local minimum
+ * a random Kempe chain is tried first; if it doesn't lower the conflicts the weight of every conflicting edge is
+ * bumped, which reshapes the objective until the minimum is left. The bumps
+ * are also added to a weight table in the shared memory, so every generator learns which edges are hard. The table
+ * is indexed by a hash of the edge and is periodically smoothed so that old bumps fade out.
+ */
+
+#pragma once
+#include "graph.h"
+
+/**
+ * @brief Run the weighted search until the callback requests termination.
+ *
+ * @details Every coloring with less conflicts than all colorings before is submitted through the callback. The search
+ * restarts from a fresh coloring if it does not improve for a while, reloading the shared weights each time.
+ * Global variables: myshm.
+ *
+ * @param g         The graph.
+ * @param report    The callback for submitting colorings.
+ * @return Returns 0 on success and -1 if memory could not be allocated.
+ */
+int weightedSearch(const graph_t *g, report_fn report);